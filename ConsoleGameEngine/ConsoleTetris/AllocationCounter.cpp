@@ -0,0 +1,61 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "AllocationCounter.h"
+
+static thread_local unsigned long long threadAllocations = 0;
+static std::atomic<unsigned long long> totalAllocations(0);
+
+/**
+ * CountedAllocate()
+ * Allocates memory from the heap and counts the allocation.
+ * @param size The number of bytes needed.
+ * @return Pointer to the memory, or nullptr if it couldn't be allocated.
+ */
+static void* CountedAllocate(std::size_t size)
+{
+	++threadAllocations;
+	totalAllocations.fetch_add(1, std::memory_order_relaxed);
+	return malloc(size == 0 ? 1 : size);
+}
+
+/**
+ * ThreadAllocations()
+ * @return The number of heap allocations made by the calling thread since it started.
+ */
+unsigned long long Engine::AllocationCounter::ThreadAllocations() { return threadAllocations; }
+
+/**
+ * TotalAllocations()
+ * @return The number of heap allocations made by every thread since the program started.
+ */
+unsigned long long Engine::AllocationCounter::TotalAllocations() { return totalAllocations.load(std::memory_order_relaxed); }
+
+// GLOBAL OPERATOR REPLACEMENTS ##############################################################################################################################
+
+void* operator new(std::size_t size)
+{
+	void* memory = CountedAllocate(size);
+	if (memory == nullptr)
+		throw std::bad_alloc();
+	return memory;
+}
+
+void* operator new[](std::size_t size)
+{
+	void* memory = CountedAllocate(size);
+	if (memory == nullptr)
+		throw std::bad_alloc();
+	return memory;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return CountedAllocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return CountedAllocate(size); }
+
+void operator delete(void* memory) noexcept { free(memory); }
+void operator delete[](void* memory) noexcept { free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { free(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { free(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { free(memory); }
\ No newline at end of file
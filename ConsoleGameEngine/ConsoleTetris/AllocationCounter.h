@@ -0,0 +1,16 @@
+#pragma once
+
+namespace Engine
+{
+	/**
+	 * AllocationCounter
+	 * Counts heap allocations by replacing the global operator new, so hot paths can be checked for allocating every frame.
+	 * Counts are kept per thread as well as in total, so the simulation can be measured on its own.
+	 */
+	class AllocationCounter
+	{
+	public:
+		static unsigned long long ThreadAllocations(void);
+		static unsigned long long TotalAllocations(void);
+	};
+}
\ No newline at end of file
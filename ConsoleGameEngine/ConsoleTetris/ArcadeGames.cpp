@@ -7,8 +7,10 @@
  * @param height Character height of the screen.
  * @param width Pixel width of the font.
  * @param height Pixel height of the font.
+ * @param startState The ID of the app to start in, 0 for the main menu.
  */
-ArcadeGames::ArcadeGames(std::wstring name, int width, int height, int fontWidth, int fontHeight) : GameEngine(name, width, height, fontWidth, fontHeight) { }
+ArcadeGames::ArcadeGames(std::wstring name, int width, int height, int fontWidth, int fontHeight, int startState) : GameEngine(name, width, height, fontWidth, fontHeight),
+	startState(startState) { }
 
 /*
  * Destructor
@@ -45,6 +47,12 @@ bool ArcadeGames::CreateGame()
 	gameStates[9] = new ThreeDimentions(this, 9);
 	gameStates[10] = new SideScroller(this, 10);
 
+	if (startState > 0 && startState < numOfStates)
+	{
+		state = startState;
+		UpdateWindow();
+	}
+
 	return true;
 }
 
@@ -76,15 +84,6 @@ bool ArcadeGames::RunGame()
  */
 void ArcadeGames::UpdateWindow()
 {
-	screenWidth = gameStates[state]->ScreenWidth();
-	screenHeight = gameStates[state]->ScreenHeight();
-
 	// Resets screen buffer ready for the new app
-	if (screenBuffer != NULL)
-		delete[] screenBuffer;
-
-	screenBuffer = new CHAR_INFO[screenWidth * screenHeight];
-	memset(screenBuffer, 0, sizeof(CHAR_INFO) * screenWidth * screenHeight);
-
-	RenderEngine::Instance().SetupWindow(screenWidth, screenHeight, gameStates[state]->FontWidth(), gameStates[state]->FontHeight());
+	ResizeScreen(gameStates[state]->ScreenWidth(), gameStates[state]->ScreenHeight(), gameStates[state]->FontWidth(), gameStates[state]->FontHeight());
 }
\ No newline at end of file
@@ -26,6 +26,7 @@ private:
 
 	Application** gameStates;
 	int state;
+	int startState;
 
 	// Overridden Functions
 	bool CreateGame(void) override;
@@ -35,6 +36,6 @@ private:
 	void UpdateWindow(void);
 
 public:
-	ArcadeGames(std::wstring name = L"Arcade Games", int width = 80, int height = 30, int fontWidth = 8, int fontHeight = 16);
+	ArcadeGames(std::wstring name = L"Arcade Games", int width = 80, int height = 30, int fontWidth = 8, int fontHeight = 16, int startState = 0);
 	~ArcadeGames(void);
 };
\ No newline at end of file
@@ -14,10 +14,11 @@
  * @param mazeHeight The cell height of the maze.
  */
 AutoMaze::AutoMaze(GameEngine* engine, int appID, int width, int height, int fontWidth, int fontHeight, int mazeWidth, int mazeHeight) : Application(engine, appID, width, height, fontWidth, fontHeight),
-	mazeWidth(mazeWidth), mazeHeight(mazeHeight), visitedCount(0), startPosition(0, 0)
+	mazeWidth(mazeWidth), mazeHeight(mazeHeight), visitedCount(0), startPosition(0, 0), animating(true)
 {
 	visited = new bool[mazeWidth * mazeHeight];
 	memset(visited, 0, sizeof(bool) * mazeWidth * mazeHeight);
+	maze = new MazeGrid(mazeWidth, mazeHeight);
 
 	GenerateAssets();
 }
@@ -29,6 +30,8 @@ AutoMaze::~AutoMaze()
 {
 	if (visited != NULL)
 		delete[] visited;
+	if (maze != NULL)
+		delete maze;
 }
 
 /*
@@ -58,7 +61,18 @@ int AutoMaze::Update()
  */
 void AutoMaze::GameLogic()
 {
-	if (visitedCount < mazeWidth * mazeHeight)
+	// '1' - '4' = Carve a whole maze at once with the backtracker, Wilson's, Eller's or Kruskal's algorithm
+	for (int i = 0; i < 4; ++i)
+	{
+		if (InputHandler::Instance().IsKeyPressed('1' + i))
+		{
+			MazeGenerator::Generate(*maze, (MazeGenerator::Algorithm)i, random);
+			animating = false;
+			engine->ClearScreen();
+		}
+	}
+
+	if (animating && visitedCount < mazeWidth * mazeHeight)
 	{
 		// Get random neighbour
 		Vector2 currentNeighbour = GetRandomNeighbour(path.top());
@@ -74,17 +88,29 @@ void AutoMaze::GameLogic()
 			
 			// Draw where the wall use to be
 			if (currentNeighbour.y < path.top().y) // Up
+			{
+				maze->Carve(path.top().x, path.top().y, MazeGrid::Direction::North);
 				for (int i = 0; i < pathWidth; i++)
 					engine->DrawChar((path.top().x * (pathWidth + 1)) + i, (path.top().y * (pathWidth + 1)) - 1 , PIXEL_SOLID, FG_WHITE);
+			}
 			else if (currentNeighbour.x > path.top().x) // Right
+			{
+				maze->Carve(path.top().x, path.top().y, MazeGrid::Direction::East);
 				for (int i = 0; i < pathWidth; i++)
 					engine->DrawChar((path.top().x * (pathWidth + 1)) + pathWidth, (path.top().y * (pathWidth + 1)) + i, PIXEL_SOLID, FG_WHITE);
+			}
 			else if (currentNeighbour.y > path.top().y) // Down
+			{
+				maze->Carve(path.top().x, path.top().y, MazeGrid::Direction::South);
 				for (int i = 0; i < pathWidth; i++)
 					engine->DrawChar((path.top().x * (pathWidth + 1)) + i, (path.top().y * (pathWidth + 1)) + pathWidth, PIXEL_SOLID, FG_WHITE);
+			}
 			else if (currentNeighbour.x < path.top().x) // Left
+			{
+				maze->Carve(path.top().x, path.top().y, MazeGrid::Direction::West);
 				for (int i = 0; i < pathWidth; i++)
 					engine->DrawChar((path.top().x * (pathWidth + 1)) - 1, (path.top().y * (pathWidth + 1)) + i, PIXEL_SOLID, FG_WHITE);
+			}
 
 			path.push(currentNeighbour);
 		}	
@@ -97,6 +123,12 @@ void AutoMaze::GameLogic()
  */
 void AutoMaze::Draw()
 {
+	if (!animating)
+	{
+		DrawMaze();
+		return;
+	}
+
 	for (int x = 0; x < mazeWidth; ++x)
 	{
 		for (int y = 0; y < mazeHeight; ++y)
@@ -114,6 +146,29 @@ void AutoMaze::Draw()
 		PIXEL_SOLID, FG_GREEN, PIXEL_SOLID, FG_GREEN);
 }
 
+/*
+ * DrawMaze()
+ * Draws the finished maze straight from its walls, each cell and each carved wall in white.
+ */
+void AutoMaze::DrawMaze()
+{
+	for (int y = 0; y < mazeHeight; ++y)
+	{
+		for (int x = 0; x < mazeWidth; ++x)
+		{
+			int left = x * (pathWidth + 1), top = y * (pathWidth + 1);
+			engine->DrawRectFill(left, top, left + pathWidth - 1, top + pathWidth - 1, PIXEL_SOLID, FG_WHITE, PIXEL_SOLID, FG_WHITE);
+
+			if (!maze->HasWall(x, y, MazeGrid::Direction::East))
+				for (int i = 0; i < pathWidth; i++)
+					engine->DrawChar(left + pathWidth, top + i, PIXEL_SOLID, FG_WHITE);
+			if (!maze->HasWall(x, y, MazeGrid::Direction::South))
+				for (int i = 0; i < pathWidth; i++)
+					engine->DrawChar(left + i, top + pathWidth, PIXEL_SOLID, FG_WHITE);
+		}
+	}
+}
+
 /*
  * Reset()
  * Resets the game back to the beginning state.
@@ -129,6 +184,8 @@ void AutoMaze::Reset()
 		path.pop();
 
 	visitedCount = 0;
+	maze->Fill();
+	animating = true;
 
 	GenerateAssets();
 	engine->ClearScreen();
@@ -168,21 +225,23 @@ bool AutoMaze::GetVisited(const int& x, const int& y) const
  * @param y The Y coordinate of the cell.
  * @return Position of the neighbour cell selected.
  */
-Vector2 AutoMaze::GetRandomNeighbour(const int& x, const int& y) const
+Vector2 AutoMaze::GetRandomNeighbour(const int& x, const int& y)
 {
-	std::vector<Vector2> options;
+	// There are only ever 4 neighbours so keep them on the stack rather than allocating
+	Vector2 options[4];
+	int optionCount = 0;
 
-	if (!GetVisited(x, y - 1)) options.push_back(Vector2(x, y - 1)); // Up
-	if (!GetVisited(x + 1, y)) options.push_back(Vector2(x + 1, y)); // Right
-	if (!GetVisited(x, y + 1)) options.push_back(Vector2(x, y + 1)); // Down
-	if (!GetVisited(x - 1, y)) options.push_back(Vector2(x - 1, y)); // Left
+	if (!GetVisited(x, y - 1)) options[optionCount++] = Vector2(x, y - 1); // Up
+	if (!GetVisited(x + 1, y)) options[optionCount++] = Vector2(x + 1, y); // Right
+	if (!GetVisited(x, y + 1)) options[optionCount++] = Vector2(x, y + 1); // Down
+	if (!GetVisited(x - 1, y)) options[optionCount++] = Vector2(x - 1, y); // Left
 
-	if (options.empty())
+	if (optionCount == 0)
 		return Vector2(-1, -1);
 	else
-		return options[rand() % options.size()];
+		return options[random.NextBelow(optionCount)];
 }
-Vector2 AutoMaze::GetRandomNeighbour(const Vector2& pos) const { return GetRandomNeighbour(pos.x, pos.y); }
+Vector2 AutoMaze::GetRandomNeighbour(const Vector2& pos) { return GetRandomNeighbour(pos.x, pos.y); }
 
 /*
  * SetVisited()
@@ -4,12 +4,15 @@
 
 #include "Application.h"
 #include "GameEngine.h"
+#include "MazeGenerator.h"
+#include "XorShift.h"
 
 using namespace Engine;
 
 /*
  * AutoMaze
  * Implements an algorithm that will create a random maze of any size starting from the top left of the screen.
+ * The maze is carved one step a frame to show the recursive backtracker at work, or all at once by any of the MazeGenerator algorithms.
  */
 class AutoMaze : public Application
 {
@@ -23,17 +26,22 @@ private:
 	int visitedCount;
 	Vector2 startPosition;
 
+	MazeGrid* maze;
+	XorShift random;
+	bool animating;
+
 	// Game Logic Functions
 	void GameLogic(void) override;
 	void Draw(void) override;
+	void DrawMaze(void);
 	void Reset(void);
 
 	// Misc Functions
 	void GenerateAssets(void) override;
 
 	bool GetVisited(const int& x, const int& y) const;
-	Vector2 GetRandomNeighbour(const int& x, const int& y) const;
-	Vector2 GetRandomNeighbour(const Vector2& pos) const;
+	Vector2 GetRandomNeighbour(const int& x, const int& y);
+	Vector2 GetRandomNeighbour(const Vector2& pos);
 
 	void SetVisited(const int& x, const int& y);
 	void SetVisited(const Vector2& pos);
@@ -0,0 +1,663 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "Benchmark.h"
+#include "FrameArena.h"
+#include "GameEngine.h"
+#include "HashLife.h"
+#include "LifeGrid.h"
+#include "LifePattern.h"
+#include "MazeGenerator.h"
+#include "Matrix4x4.h"
+#include "Mesh.h"
+
+using namespace Engine::Graphics;
+using namespace Engine::Physics;
+
+/*
+ * Run()
+ * Runs the benchmark named on the command line and prints the result.
+ * Usage: --bench load [objFile] [iterations]
+ *        --bench transform [objFile] [iterations]
+ *        --bench instances [objFile] [iterations]
+ *        --bench raster [objFile] [iterations]
+ *        --bench tiles [objFile] [iterations]
+ *        --bench life [patternFile] [generations]
+ *        --bench maze [size] [iterations]
+ * @return The exit code of the program.
+ */
+int Engine::Benchmark::Run(int argc, char* argv[])
+{
+	if (argc > 2 && strcmp(argv[2], "load") == 0)
+	{
+		int iterations = (argc > 4) ? atoi(argv[4]) : 50;
+		const char* defaultFiles[] = { "../Assets/Models/Head.obj", "../Assets/Models/teapot.obj" };
+
+		for (int i = 0; i < ((argc > 3) ? 1 : 2); ++i)
+		{
+			std::string objFile = (argc > 3) ? argv[3] : defaultFiles[i];
+
+			size_t triangles = 0;
+			double nanoseconds = LoadMesh(objFile, iterations, false, triangles);
+			if (nanoseconds < 0.0)
+			{
+				printf("Could not load %s\n", objFile.c_str());
+				return 1;
+			}
+			printf("Parse OBJ      (%s): %.1f us per load (%zu triangles)\n", objFile.c_str(), nanoseconds / 1000.0, triangles);
+
+			nanoseconds = LoadMesh(objFile, iterations, true, triangles);
+			printf("Load .meshbin  (%s): %.1f us per load (%zu triangles)\n", objFile.c_str(), nanoseconds / 1000.0, triangles);
+		}
+		return 0;
+	}
+
+	if (argc > 2 && strcmp(argv[2], "transform") == 0)
+	{
+		std::string objFile = (argc > 3) ? argv[3] : "../Assets/Models/Head.obj";
+		int iterations = (argc > 4) ? atoi(argv[4]) : 200;
+
+		float checksum = 0.0f;
+		double nanoseconds = TriangleTransform(objFile, iterations, checksum);
+		if (nanoseconds < 0.0)
+		{
+			printf("Could not load %s\n", objFile.c_str());
+			return 1;
+		}
+		printf("Triangle transform (%s): %.2f ns per triangle (checksum %f)\n", objFile.c_str(), nanoseconds, checksum);
+
+		nanoseconds = MeshTransform(objFile, iterations, checksum);
+		printf("Mesh transform     (%s): %.2f ns per triangle (checksum %f)\n", objFile.c_str(), nanoseconds, checksum);
+		return 0;
+	}
+
+	if (argc > 2 && strcmp(argv[2], "instances") == 0)
+	{
+		std::string objFile = (argc > 3) ? argv[3] : "../Assets/Models/Head.obj";
+		int iterations = (argc > 4) ? atoi(argv[4]) : 20;
+		const int instanceCounts[] = { 1, 16, 256 };
+
+		for (int instances : instanceCounts)
+		{
+			float checksum = 0.0f;
+			double nanoseconds = InstanceTransform(objFile, instances, iterations, false, checksum);
+			if (nanoseconds < 0.0)
+			{
+				printf("Could not load %s\n", objFile.c_str());
+				return 1;
+			}
+			printf("One at a time (%s), %3d instances: %.2f ns per vertex (checksum %f)\n", objFile.c_str(), instances, nanoseconds, checksum);
+
+			nanoseconds = InstanceTransform(objFile, instances, iterations, true, checksum);
+			printf("Batched       (%s), %3d instances: %.2f ns per vertex (checksum %f)\n", objFile.c_str(), instances, nanoseconds, checksum);
+		}
+		return 0;
+	}
+
+	if (argc > 2 && strcmp(argv[2], "raster") == 0)
+	{
+		int iterations = (argc > 4) ? atoi(argv[4]) : 200;
+		const char* defaultFiles[] = { "../Assets/Models/Head.obj", "../Assets/Models/teapot.obj" };
+		int threads = ThreadPool::DefaultWorkerCount() + 1;
+
+		for (int i = 0; i < ((argc > 3) ? 1 : 2); ++i)
+		{
+			std::string objFile = (argc > 3) ? argv[3] : defaultFiles[i];
+
+			int trianglesDrawn = 0;
+			int coveredCells = 0;
+			double nanoseconds = Rasterise(objFile, iterations, RasterMode::PaintersSort, 1, trianglesDrawn, coveredCells);
+			if (nanoseconds < 0.0)
+			{
+				printf("Could not load %s\n", objFile.c_str());
+				return 1;
+			}
+			printf("Painter's sort            (%s): %.1f us per frame (%d cells covered)\n", objFile.c_str(), nanoseconds / 1000.0, coveredCells);
+
+			nanoseconds = Rasterise(objFile, iterations, RasterMode::DepthBuffer, 1, trianglesDrawn, coveredCells);
+			printf("Depth buffer              (%s): %.1f us per frame (%d cells covered)\n", objFile.c_str(), nanoseconds / 1000.0, coveredCells);
+
+			nanoseconds = Rasterise(objFile, iterations, RasterMode::TiledDepthBuffer, threads, trianglesDrawn, coveredCells);
+			printf("Tiled depth buffer, %2d thr (%s): %.1f us per frame (%d cells covered)\n", threads, objFile.c_str(), nanoseconds / 1000.0, coveredCells);
+
+			nanoseconds = Rasterise(objFile, iterations, RasterMode::GouraudDepthBuffer, threads, trianglesDrawn, coveredCells);
+			printf("Gouraud + dither,   %2d thr (%s): %.1f us per frame (%d cells covered)\n", threads, objFile.c_str(), nanoseconds / 1000.0, coveredCells);
+
+			nanoseconds = Rasterise(objFile, iterations, RasterMode::TexturedDepthBuffer, threads, trianglesDrawn, coveredCells);
+			printf("Textured,           %2d thr (%s): %.1f us per frame (%d cells covered)\n", threads, objFile.c_str(), nanoseconds / 1000.0, coveredCells);
+		}
+		return 0;
+	}
+
+	if (argc > 2 && strcmp(argv[2], "tiles") == 0)
+	{
+		std::string objFile = (argc > 3) ? argv[3] : "../Assets/Models/teapot.obj";
+		int iterations = (argc > 4) ? atoi(argv[4]) : 200;
+		int maxThreads = ThreadPool::DefaultWorkerCount() + 1;
+
+		// Doubles the threads each run, finishing on every hardware thread
+		for (int threads = 1; ; threads = (threads * 2 < maxThreads) ? threads * 2 : maxThreads)
+		{
+			int trianglesDrawn = 0;
+			int coveredCells = 0;
+			double nanoseconds = Rasterise(objFile, iterations, RasterMode::TiledDepthBuffer, threads, trianglesDrawn, coveredCells);
+			if (nanoseconds < 0.0)
+			{
+				printf("Could not load %s\n", objFile.c_str());
+				return 1;
+			}
+			printf("Tiled depth buffer (%s), %2d threads: %.2f million triangles/s\n", objFile.c_str(), threads, (double)trianglesDrawn / nanoseconds * 1000.0);
+
+			if (threads >= maxThreads)
+				break;
+		}
+		return 0;
+	}
+
+	if (argc > 2 && strcmp(argv[2], "life") == 0)
+	{
+		int generations = (argc > 4) ? atoi(argv[4]) : 200;
+		int maxThreads = ThreadPool::DefaultWorkerCount() + 1;
+		const int size = 1024;
+
+		// A 50% random soup keeps every tile busy, so this is the kernel's full speed
+		for (int threads = 1; ; threads = (threads * 2 < maxThreads) ? threads * 2 : maxThreads)
+		{
+			size_t population = 0;
+			double nanoseconds = LifeGridGenerations("", "B3/S23", size, generations, threads, population);
+			printf("LifeGrid soup,    B3/S23,  %2d thr (%dx%d): %.1f million cell updates/s (population %zu)\n", threads, size, size, (double)size * size / nanoseconds * 1000.0, population);
+
+			if (threads >= maxThreads)
+				break;
+		}
+
+		size_t population = 0;
+		double nanoseconds = LifeGridGenerations("", "B36/S23", size, generations, 1, population);
+		printf("LifeGrid soup,    B36/S23,  1 thr (%dx%d): %.1f million cell updates/s (population %zu)\n", size, size, (double)size * size / nanoseconds * 1000.0, population);
+
+		// Patterns only keep a few tiles busy, so these count the cells that were skipped as updated too
+		const char* defaultFiles[] = { "../Assets/Life/Acorn.rle", "../Assets/Life/GosperGliderGun.rle" };
+		for (int i = 0; i < ((argc > 3) ? 1 : 2); ++i)
+		{
+			std::string patternFile = (argc > 3) ? argv[3] : defaultFiles[i];
+			nanoseconds = LifeGridGenerations(patternFile, "", size, generations, 1, population);
+			if (nanoseconds < 0.0)
+			{
+				printf("Could not load %s\n", patternFile.c_str());
+				return 1;
+			}
+			printf("LifeGrid pattern,           1 thr (%s): %.1f million cell updates/s (population %zu)\n", patternFile.c_str(), (double)size * size / nanoseconds * 1000.0, population);
+
+			for (int stepLog2 = 0; stepLog2 <= 10; stepLog2 += 5)
+			{
+				uint64_t hashPopulation = 0;
+				size_t nodes = 0;
+				const int steps = 64;
+				nanoseconds = HashLifeSteps(patternFile, stepLog2, steps, hashPopulation, nodes);
+				if (nanoseconds < 0.0)
+				{
+					// The pattern loaded above, so it's the rule HashLife turned down
+					LifePattern pattern;
+					pattern.LoadFromFile(patternFile);
+					printf("HashLife cannot run %s (%s)\n", pattern.rule.ToString().c_str(), patternFile.c_str());
+					break;
+				}
+				printf("HashLife pattern, 2^%-2d per step  (%s): %.1f us per step, %.0f generations/s (population %llu after %llu generations, %zu nodes)\n",
+					stepLog2, patternFile.c_str(), nanoseconds / 1000.0, (double)(1ULL << stepLog2) / nanoseconds * 1e9, (unsigned long long)hashPopulation, (unsigned long long)steps << stepLog2, nodes);
+			}
+		}
+		return 0;
+	}
+
+	if (argc > 2 && strcmp(argv[2], "maze") == 0)
+	{
+		int size = (argc > 3) ? atoi(argv[3]) : 1024;
+		int iterations = (argc > 4) ? atoi(argv[4]) : 5;
+		if (size <= 0 || iterations <= 0)
+		{
+			printf("Usage: %s --bench maze [size] [iterations], both above 0\n", argv[0]);
+			return 1;
+		}
+
+		for (int i = 0; i < 4; ++i)
+		{
+			MazeGenerator::Algorithm algorithm = (MazeGenerator::Algorithm)i;
+			size_t passages = 0;
+			double nanoseconds = MazeGeneration(algorithm, size, iterations, passages);
+			printf("%-11s (%dx%d): %.1f ms per maze, %.1f million cells/s (%zu passages)\n", MazeGenerator::AlgorithmName(algorithm), size, size, nanoseconds / 1e6, (double)size * size / nanoseconds * 1000.0, passages);
+		}
+		return 0;
+	}
+
+	printf("Usage: %s --bench load|transform|instances|raster|tiles|life|maze [objFile|patternFile|size] [iterations|generations]\n", argv[0]);
+	return 1;
+}
+
+// Shared by the benchmarks so they work on the same mesh in the same place
+static Matrix4x4 BenchWorldMatrix(void)
+{
+	Matrix4x4 worldMat = Matrix4x4::RotationZMatrix(0.3f) * Matrix4x4::RotationXMatrix(0.6f);
+	worldMat = worldMat * Matrix4x4::RotationYMatrix(0.9f);
+	return worldMat * Matrix4x4::TranslationMatrix(0.0f, 0.0f, 6.0f);
+}
+
+static Matrix4x4 BenchViewMatrix(void) { return Matrix4x4::InvertPointAtMatrix(Matrix4x4::PointAtMatrix(FVector3(0.0f, 1.0f, -2.0f), FVector3(0.0f, 0.0f, 6.0f), FVector3(0.0f, 1.0f, 0.0f))); }
+static Matrix4x4 BenchProjectionMatrix(void) { return Matrix4x4::ProjectionMatrix(0.5f, 90.0f, 0.1f, 1000.0f); }
+
+/*
+ * LoadMesh()
+ * Times loading a mesh from its OBJ file, either parsing the text every time or reading the .meshbin cache.
+ * The cache is written by an untimed load first, so every timed load reads it.
+ * @param objFile The mesh to load.
+ * @param iterations The number of times to load it.
+ * @param useCache Whether to load from the cache rather than parse the OBJ file.
+ * @param triangles Set to the number of triangles in the mesh.
+ * @return The average time in nanoseconds to load the mesh, or -1 if it couldn't be loaded.
+ */
+double Engine::Benchmark::LoadMesh(const std::string& objFile, const int& iterations, const bool& useCache, size_t& triangles)
+{
+	Mesh first;
+	if (!first.LoadFromObjFile(objFile, useCache))
+		return -1.0;
+	triangles = first.TriangleCount();
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	for (int i = 0; i < iterations; ++i)
+	{
+		Mesh mesh;
+		mesh.LoadFromObjFile(objFile, useCache);
+	}
+
+	std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+	return elapsed.count() / (double)iterations;
+}
+
+/*
+ * TriangleTransform()
+ * Times taking every triangle of a mesh through the world, view and projection matrices one triangle at a time,
+ * as ThreeDimentions used to each frame. Kept as the baseline for MeshTransform().
+ * @param objFile The mesh to transform.
+ * @param iterations The number of times to transform the whole mesh.
+ * @param checksum Set to a sum of the results, so the work can't be optimised away and runs can be compared.
+ * @return The average time in nanoseconds to transform one triangle, or -1 if the mesh couldn't be loaded.
+ */
+double Engine::Benchmark::TriangleTransform(const std::string& objFile, const int& iterations, float& checksum)
+{
+	Mesh mesh;
+	if (!mesh.LoadFromObjFile(objFile) || mesh.TriangleCount() == 0)
+		return -1.0;
+
+	std::vector<Triangle> tris;
+	for (size_t i = 0; i < mesh.TriangleCount(); ++i)
+		tris.push_back(mesh.GetTriangle(i));
+
+	Matrix4x4 worldMat = BenchWorldMatrix();
+	Matrix4x4 viewMat = BenchViewMatrix();
+	Matrix4x4 projectionMat = BenchProjectionMatrix();
+
+	float sum = 0.0f;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	for (int i = 0; i < iterations; ++i)
+	{
+		for (const Triangle& tri : tris)
+		{
+			Triangle transformed = tri * worldMat;
+			transformed = transformed * viewMat;
+			transformed = transformed * projectionMat;
+			sum += transformed.points[0].x + transformed.points[1].y + transformed.points[2].z;
+		}
+	}
+
+	std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+	checksum = sum;
+	return elapsed.count() / ((double)iterations * (double)tris.size());
+}
+
+/*
+ * MeshTransform()
+ * Times Mesh::Transform(), which takes each unique vertex through the same matrices once in SIMD batches.
+ * The checksum reads the same points as TriangleTransform(), divided by w, so the two can be compared.
+ * @param objFile The mesh to transform.
+ * @param iterations The number of times to transform the whole mesh.
+ * @param checksum Set to a sum of the results, so the work can't be optimised away and runs can be compared.
+ * @return The average time in nanoseconds per triangle of the mesh, or -1 if the mesh couldn't be loaded.
+ */
+double Engine::Benchmark::MeshTransform(const std::string& objFile, const int& iterations, float& checksum)
+{
+	Mesh mesh;
+	if (!mesh.LoadFromObjFile(objFile) || mesh.TriangleCount() == 0)
+		return -1.0;
+
+	Matrix4x4 worldMat = BenchWorldMatrix();
+	Matrix4x4 viewProjectionMat = BenchViewMatrix() * BenchProjectionMatrix();
+	FrameArena arena;
+
+	float sum = 0.0f;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	for (int i = 0; i < iterations; ++i)
+	{
+		arena.Reset();
+		TransformedMesh vertices = mesh.Transform(worldMat, viewProjectionMat, arena);
+
+		const unsigned int* indices = mesh.indices.data();
+		for (size_t t = 0; t < mesh.TriangleCount(); ++t)
+		{
+			unsigned int a = indices[t * 3], b = indices[(t * 3) + 1], c = indices[(t * 3) + 2];
+			sum += (vertices.clipX[a] / vertices.clipW[a]) + (vertices.clipY[b] / vertices.clipW[b]) + (vertices.clipZ[c] / vertices.clipW[c]);
+		}
+	}
+
+	std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+	checksum = sum;
+	return elapsed.count() / ((double)iterations * (double)mesh.TriangleCount());
+}
+
+/*
+ * InstanceTransform()
+ * Times transforming many instances of a mesh, either calling Mesh::Transform() once per instance
+ * or handing all of them to Mesh::TransformInstances() together.
+ * @param objFile The mesh to transform.
+ * @param instances The number of instances, spread out in a row.
+ * @param iterations The number of times to transform every instance.
+ * @param batched Whether to transform the instances together.
+ * @param checksum Set to a sum of the results, so the two ways can be compared.
+ * @return The average time in nanoseconds per vertex of every instance, or -1 if the mesh couldn't be loaded.
+ */
+double Engine::Benchmark::InstanceTransform(const std::string& objFile, const int& instances, const int& iterations, const bool& batched, float& checksum)
+{
+	Mesh mesh;
+	if (!mesh.LoadFromObjFile(objFile) || mesh.VertexCount() == 0)
+		return -1.0;
+
+	std::vector<Matrix4x4> worlds;
+	for (int i = 0; i < instances; ++i)
+		worlds.push_back(BenchWorldMatrix() * Matrix4x4::TranslationMatrix((float)i * 3.0f, 0.0f, 0.0f));
+
+	Matrix4x4 viewProjectionMat = BenchViewMatrix() * BenchProjectionMatrix();
+	std::vector<TransformedMesh> out(instances);
+	FrameArena arena;
+
+	float sum = 0.0f;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	for (int i = 0; i < iterations; ++i)
+	{
+		arena.Reset();
+		if (batched)
+			mesh.TransformInstances(worlds.data(), worlds.size(), viewProjectionMat, arena, out.data());
+		else
+			for (int k = 0; k < instances; ++k)
+				out[k] = mesh.Transform(worlds[k], viewProjectionMat, arena);
+
+		for (const TransformedMesh& vertices : out)
+			sum += vertices.clipX[0] + vertices.clipW[vertices.vertexCount - 1];
+	}
+
+	std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+	checksum = sum;
+	return elapsed.count() / ((double)iterations * (double)instances * (double)mesh.VertexCount());
+}
+
+/*
+ * RasterEngine
+ * Just enough of a game to own a screen and depth buffer to draw into, without ever being started.
+ */
+class RasterEngine : public Engine::GameEngine
+{
+protected:
+	bool CreateGame(void) override { return true; }
+	bool RunGame(void) override { return true; }
+
+public:
+	RasterEngine(int width, int height) : GameEngine(L"Benchmark", width, height, 4, 4) { }
+
+	int CoveredCells(void) const
+	{
+		int covered = 0;
+		for (int i = 0; i < screenWidth * screenHeight; ++i)
+			covered += (screenBuffer[i].Char.UnicodeChar != ' ') ? 1 : 0;
+		return covered;
+	}
+};
+
+/*
+ * Rasterise()
+ * Times filling a mesh's triangles on a 160x160 screen the way ThreeDimentions does. The mesh is transformed, back face culled
+ * and projected each frame as well, but only clearing the screen and filling the triangles is timed.
+ * @param objFile The mesh to draw.
+ * @param iterations The number of frames to draw.
+ * @param mode How to fill the triangles.
+ * @param threads The number of threads to fill tiles with, only used by the tiled modes.
+ * @param trianglesDrawn Set to the number of triangles filled each frame.
+ * @param coveredCells Set to the number of cells the mesh covers in the last frame.
+ * @return The average time in nanoseconds to fill one frame, or -1 if the mesh couldn't be loaded.
+ */
+double Engine::Benchmark::Rasterise(const std::string& objFile, const int& iterations, const RasterMode& mode, const int& threads, int& trianglesDrawn, int& coveredCells)
+{
+	Mesh mesh;
+	if (!mesh.LoadFromObjFile(objFile) || mesh.TriangleCount() == 0)
+		return -1.0;
+
+	const int size = 160;
+	RasterEngine engine(size, size);
+	engine.RasterPool().Resize(threads - 1);
+
+	// Closer in than the transform benchmarks so the mesh fills most of the screen, making filling cells a fair part of the cost
+	FVector3 cameraPos(0.0f, 0.5f, 2.0f);
+	Matrix4x4 worldMat = BenchWorldMatrix();
+	Matrix4x4 viewMat = Matrix4x4::InvertPointAtMatrix(Matrix4x4::PointAtMatrix(cameraPos, FVector3(0.0f, 0.0f, 6.0f), FVector3(0.0f, 1.0f, 0.0f)));
+	Matrix4x4 viewProjectionMat = viewMat * Matrix4x4::ProjectionMatrix(1.0f, 90.0f, 0.1f, 1000.0f);
+
+	FVector3 light = FVector3(0.0f, 1.0f, -1.0f).Normalized();
+
+	// A checkerboard projected onto the mesh from the front, so any mesh can be textured
+	Sprite texture(32, 32);
+	for (int y = 0; y < 32; ++y)
+	{
+		for (int x = 0; x < 32; ++x)
+		{
+			texture.SetPixel(x, y, PIXEL_SOLID);
+			texture.SetColour(x, y, (((x / 4) + (y / 4)) % 2 == 0) ? FG_WHITE : FG_DARK_BLUE);
+		}
+	}
+	float textureScale = 0.5f / ((mesh.boundsRadius > 0.0f) ? mesh.boundsRadius : 1.0f);
+	std::vector<Triangle> triangles;
+	triangles.reserve(mesh.TriangleCount());
+	std::chrono::duration<double, std::nano> elapsed(0.0);
+
+	for (int i = 0; i < iterations; ++i)
+	{
+		engine.Arena().Reset();
+
+		TransformedMesh vertices = mesh.Transform(worldMat, viewProjectionMat, engine.Arena());
+		const unsigned int* indices = mesh.indices.data();
+		triangles.clear();
+
+		for (size_t t = 0; t < mesh.TriangleCount(); ++t)
+		{
+			unsigned int a = indices[t * 3], b = indices[(t * 3) + 1], c = indices[(t * 3) + 2];
+			FVector3 worldA(vertices.worldX[a], vertices.worldY[a], vertices.worldZ[a]);
+			FVector3 normal = (FVector3(vertices.worldX[b], vertices.worldY[b], vertices.worldZ[b]) - worldA).CrossProduct(FVector3(vertices.worldX[c], vertices.worldY[c], vertices.worldZ[c]) - worldA);
+			if (normal.DotProduct(worldA - cameraPos) >= 0.0f)
+				continue;
+
+			// Nothing should reach the near plane from here, but leave out anything that does rather than clip it
+			if (vertices.clipZ[a] < 0.0f || vertices.clipZ[b] < 0.0f || vertices.clipZ[c] < 0.0f)
+				continue;
+
+			Triangle tri(FVector3(vertices.clipX[a] / vertices.clipW[a], vertices.clipY[a] / vertices.clipW[a], vertices.clipZ[a] / vertices.clipW[a]),
+						 FVector3(vertices.clipX[b] / vertices.clipW[b], vertices.clipY[b] / vertices.clipW[b], vertices.clipZ[b] / vertices.clipW[b]),
+						 FVector3(vertices.clipX[c] / vertices.clipW[c], vertices.clipY[c] / vertices.clipW[c], vertices.clipZ[c] / vertices.clipW[c]));
+			tri.pixel = PIXEL_SOLID;
+			tri.colour = (short)(1 + (t % 15));
+			if (mode == RasterMode::GouraudDepthBuffer)
+			{
+				// Lit in model space, which is enough to give the rasteriser realistic gradients to shade
+				tri.shadeColour = FG_RED;
+				tri.shades[0] = (mesh.normalX[a] * light.x) + (mesh.normalY[a] * light.y) + (mesh.normalZ[a] * light.z);
+				tri.shades[1] = (mesh.normalX[b] * light.x) + (mesh.normalY[b] * light.y) + (mesh.normalZ[b] * light.z);
+				tri.shades[2] = (mesh.normalX[c] * light.x) + (mesh.normalY[c] * light.y) + (mesh.normalZ[c] * light.z);
+			}
+			else if (mode == RasterMode::TexturedDepthBuffer)
+			{
+				const unsigned int corners[3] = { a, b, c };
+				for (int k = 0; k < 3; ++k)
+				{
+					tri.texU[k] = 0.5f + ((mesh.vertexX[corners[k]] - mesh.boundsCentre.x) * textureScale);
+					tri.texV[k] = 0.5f - ((mesh.vertexY[corners[k]] - mesh.boundsCentre.y) * textureScale);
+					tri.inverseW[k] = 1.0f / vertices.clipW[corners[k]];
+				}
+				tri.texture = &texture;
+			}
+			tri *= FVector3(-1.0f, -1.0f, 1.0f);
+			tri += FVector3(1.0f, 1.0f, 0.0f);
+			tri *= FVector3(0.5f * (float)size, 0.5f * (float)size, 1.0f);
+			triangles.push_back(tri);
+		}
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		engine.ClearScreen();
+
+		if (mode == RasterMode::PaintersSort)
+		{
+			std::sort(triangles.begin(), triangles.end(), [](const Triangle& t1, const Triangle& t2)
+			{
+				return (t1.points[0].z + t1.points[1].z + t1.points[2].z) / 3.0f > (t2.points[0].z + t2.points[1].z + t2.points[2].z) / 3.0f;
+			});
+
+			for (const Triangle& tri : triangles)
+				engine.DrawFillTriangle((int)tri.points[0].x, (int)tri.points[0].y, (int)tri.points[1].x, (int)tri.points[1].y, (int)tri.points[2].x, (int)tri.points[2].y, tri.pixel, tri.colour);
+		}
+		else if (mode == RasterMode::DepthBuffer)
+		{
+			engine.ClearDepth();
+			for (const Triangle& tri : triangles)
+				engine.DrawFillTriangleDepth(tri.points[0].x, tri.points[0].y, tri.points[0].z, tri.points[1].x, tri.points[1].y, tri.points[1].z, tri.points[2].x, tri.points[2].y, tri.points[2].z, tri.pixel, tri.colour);
+		}
+		else
+		{
+			engine.ClearDepth();
+			engine.DrawFillTrianglesDepth(triangles.data(), triangles.size());
+		}
+
+		elapsed += std::chrono::steady_clock::now() - start;
+	}
+
+	trianglesDrawn = (int)triangles.size();
+	coveredCells = engine.CoveredCells();
+	return elapsed.count() / (double)iterations;
+}
+
+/*
+ * LifeGridGenerations()
+ * Times stepping a LifeGrid, starting from a pattern in the middle of the board or from a 50% random soup with a fixed seed.
+ * @param patternFile The pattern to start from, or an empty string for a random soup.
+ * @param rule The rule to run, or an empty string for the pattern's own rule.
+ * @param size The width and height of the board.
+ * @param generations The number of generations to step.
+ * @param threads The number of threads to share the tiles between.
+ * @param population Set to the number of living cells at the end.
+ * @return The average time in nanoseconds to step one generation, or -1 if the pattern couldn't be loaded.
+ */
+double Engine::Benchmark::LifeGridGenerations(const std::string& patternFile, const std::string& rule, const int& size, const int& generations, const int& threads, size_t& population)
+{
+	LifeGrid grid(size, size);
+	if (patternFile.empty())
+	{
+		srand(1);
+		for (int y = 0; y < size; ++y)
+			for (int x = 0; x < size; ++x)
+				grid.Set(x, y, rand() % 2 == 1);
+	}
+	else
+	{
+		LifePattern pattern;
+		if (!pattern.LoadFromFile(patternFile))
+			return -1.0;
+		if (pattern.hasRule)
+			grid.SetRule(pattern.rule);
+		for (size_t i = 0; i < pattern.CellCount(); ++i)
+			grid.Set(((size - pattern.width) / 2) + pattern.cellX[i], ((size - pattern.height) / 2) + pattern.cellY[i], true);
+	}
+
+	if (!rule.empty())
+	{
+		LifeRule parsed;
+		parsed.Parse(rule);
+		grid.SetRule(parsed);
+	}
+
+	ThreadPool pool(threads - 1);
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	for (int i = 0; i < generations; ++i)
+		grid.Step(threads > 1 ? &pool : nullptr);
+
+	std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+	population = grid.Population();
+	return elapsed.count() / (double)generations;
+}
+
+/*
+ * HashLifeSteps()
+ * Times stepping a pattern in a HashLife universe, including the time to build up the cache from empty.
+ * @param patternFile The pattern to run, under its own rule.
+ * @param stepLog2 How many generations each step skips, as a power of 2.
+ * @param steps The number of steps.
+ * @param population Set to the number of living cells at the end.
+ * @param nodes Set to the number of nodes in memory at the end.
+ * @return The average time in nanoseconds per step, or -1 if the pattern couldn't be loaded.
+ */
+double Engine::Benchmark::HashLifeSteps(const std::string& patternFile, const int& stepLog2, const int& steps, uint64_t& population, size_t& nodes)
+{
+	LifePattern pattern;
+	if (!pattern.LoadFromFile(patternFile))
+		return -1.0;
+
+	HashLife universe;
+	if (pattern.hasRule && !universe.SetRule(pattern.rule))
+		return -1.0;
+	for (size_t i = 0; i < pattern.CellCount(); ++i)
+		universe.Set(pattern.cellX[i], pattern.cellY[i], true);
+	universe.SetStepLog2(stepLog2);
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	for (int i = 0; i < steps; ++i)
+		universe.Step();
+
+	std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+	population = universe.Population();
+	nodes = universe.NodeCount();
+	return elapsed.count() / (double)steps;
+}
+
+/*
+ * MazeGeneration()
+ * Times carving a whole square maze with one of the MazeGenerator algorithms, from a fixed seed.
+ * @param algorithm The algorithm to carve with.
+ * @param size The width and height of the maze in cells.
+ * @param iterations The number of mazes to carve.
+ * @param passages Set to the number of walls carved in the last maze, one fewer than the number of cells if it is perfect.
+ * @return The average time in nanoseconds to carve one maze.
+ */
+double Engine::Benchmark::MazeGeneration(const MazeGenerator::Algorithm& algorithm, const int& size, const int& iterations, size_t& passages)
+{
+	MazeGrid maze(size, size);
+	XorShift random(1);
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	for (int i = 0; i < iterations; ++i)
+		MazeGenerator::Generate(maze, algorithm, random);
+
+	std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+	passages = maze.PassageCount();
+	return elapsed.count() / (double)iterations;
+}
\ No newline at end of file
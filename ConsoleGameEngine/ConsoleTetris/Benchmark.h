@@ -0,0 +1,41 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "MazeGenerator.h"
+
+namespace Engine
+{
+	/**
+	 * Benchmark
+	 * Micro-benchmarks for the engine's hot paths, run from the command line with --bench.
+	 */
+	class Benchmark
+	{
+	public:
+		/**
+		 * RasterMode
+		 * The ways Rasterise() can fill a mesh's triangles.
+		 */
+		enum class RasterMode
+		{
+			PaintersSort,		// Sorted back to front and drawn over each other
+			DepthBuffer,		// Drawn one at a time against the depth buffer
+			TiledDepthBuffer,	// Binned into tiles that are drawn against the depth buffer in parallel
+			GouraudDepthBuffer,	// As TiledDepthBuffer, but shaded cell by cell from the shade table with dithering
+			TexturedDepthBuffer	// As TiledDepthBuffer, but filled from a texture with perspective correct coordinates
+		};
+
+		static int Run(int argc, char* argv[]);
+
+		static double LoadMesh(const std::string& objFile, const int& iterations, const bool& useCache, size_t& triangles);
+		static double TriangleTransform(const std::string& objFile, const int& iterations, float& checksum);
+		static double MeshTransform(const std::string& objFile, const int& iterations, float& checksum);
+		static double InstanceTransform(const std::string& objFile, const int& instances, const int& iterations, const bool& batched, float& checksum);
+		static double Rasterise(const std::string& objFile, const int& iterations, const RasterMode& mode, const int& threads, int& trianglesDrawn, int& coveredCells);
+		static double LifeGridGenerations(const std::string& patternFile, const std::string& rule, const int& size, const int& generations, const int& threads, size_t& population);
+		static double HashLifeSteps(const std::string& patternFile, const int& stepLog2, const int& steps, uint64_t& population, size_t& nodes);
+		static double MazeGeneration(const MazeGenerator::Algorithm& algorithm, const int& size, const int& iterations, size_t& passages);
+	};
+}
\ No newline at end of file
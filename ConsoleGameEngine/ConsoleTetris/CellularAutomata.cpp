@@ -1,5 +1,25 @@
+#include <cmath>
+#include <cwchar>
+#include <string>
+
 #include "CellularAutomata.h"
 
+// How far the HashLife view can zoom in and out, as a power of 2 of cells per character
+static const int MIN_ZOOM = -3;
+static const int MAX_ZOOM = 48;
+
+// How fast the HashLife view pans, in characters per second
+static const double PAN_SPEED = 64.0;
+
+// The patterns 'P' steps through after the random soup
+static const int PATTERN_COUNT = 5;
+static const char* PATTERN_FILES[PATTERN_COUNT] = { "../Assets/Life/GosperGliderGun.rle", "../Assets/Life/Acorn.rle", "../Assets/Life/RPentomino.cells",
+													"../Assets/Life/Pulsar.cells", "../Assets/Life/Replicator.rle" };
+
+// The rules 'R' steps through
+static const int RULE_COUNT = 5;
+static const char* RULES[RULE_COUNT] = { "B3/S23", "B36/S23", "B3678/S34678", "B2/S", "B368/S245" };
+
 /*
  * Constructor
  * @param screenBuffer A pointer to the screenbuffer to be able to draw to.
@@ -13,11 +33,16 @@
  */
 CellularAutomata::CellularAutomata(GameEngine* engine, int appID, int width, int height, int fontWidth, int fontHeight) : Application(engine, appID, width, height, fontWidth, fontHeight)
 {
-	currentState = new bool[screenWidth * screenHeight];
-	newState = new bool[screenWidth * screenHeight];
-
-	memset(currentState, 0, sizeof(bool) * screenWidth * screenHeight);
-	memset(newState, 0, sizeof(bool) * screenWidth * screenHeight);
+	grid = new LifeGrid(screenWidth, screenHeight);
+	redrawGrid = true;
+	patternIndex = -1;
+	ruleIndex = 0;
+	universe = new HashLife();
+	hashLifeMode = false;
+	coverage = new float[screenWidth * screenHeight];
+	viewX = 0.0;
+	viewY = 0.0;
+	zoom = 0;
 
 	GenerateAssets();
 }
@@ -27,10 +52,12 @@ CellularAutomata::CellularAutomata(GameEngine* engine, int appID, int width, int
  */
 CellularAutomata::~CellularAutomata()
 {
-	if (currentState != NULL)
-		delete[] currentState;
-	if (newState != NULL)
-		delete[] newState;
+	if (grid != NULL)
+		delete grid;
+	if (universe != NULL)
+		delete universe;
+	if (coverage != NULL)
+		delete[] coverage;
 }
 
 /*
@@ -40,25 +67,8 @@ CellularAutomata::~CellularAutomata()
  */
 int CellularAutomata::Update()
 {
-	for (int x = 0; x < screenWidth; ++x)
-	{
-		for (int y = 0; y < screenHeight; ++y)
-		{
-			int count = GetNeighbors(x, y);
-			if (currentState[(y * screenWidth) + x]) // If alive - check for over or under population
-				newState[(y * screenWidth) + x] = (count == 2 || count == 3);
-			else // If dead - check for 3 neighbors and breed
-				newState[(y * screenWidth) + x] = count == 3;
-
-			// Draw Cell
-			if (newState[(y * screenWidth) + x])
-				engine->DrawChar(x, y);
-			else
-				engine->DrawChar(x, y, ' ');
-		}
-	}
-
-	memcpy(currentState, newState, sizeof(bool) * screenWidth * screenHeight);
+	GameLogic();
+	Draw();
 
 	if (InputHandler::Instance().IsKeyPressed(VK_RETURN))
 		Reset();
@@ -71,27 +81,198 @@ int CellularAutomata::Update()
 	return appID;
 }
 
-void CellularAutomata::GameLogic() { }
-void CellularAutomata::Draw() { }
+/*
+ * GameLogic()
+ * Runs the main logic for the game.
+ */
+void CellularAutomata::GameLogic()
+{
+	// 'H' = Switch between the grid and HashLife, carrying the current cells over
+	if (InputHandler::Instance().IsKeyPressed('H'))
+	{
+		hashLifeMode = !hashLifeMode;
+		if (hashLifeMode)
+			SeedUniverse();
+		else
+			redrawGrid = true;
+	}
+
+	// 'P' = Load the next pattern, going back to a random soup after the last one
+	if (InputHandler::Instance().IsKeyPressed('P'))
+	{
+		patternIndex = (patternIndex + 1 < PATTERN_COUNT) ? patternIndex + 1 : -1;
+		LoadPattern();
+	}
+
+	// 'R' = Run the current cells under the next rule
+	if (InputHandler::Instance().IsKeyPressed('R'))
+	{
+		ruleIndex = (ruleIndex + 1) % RULE_COUNT;
+		LifeRule rule;
+		rule.Parse(RULES[ruleIndex]);
+		grid->SetRule(rule);
+		if (hashLifeMode && !universe->SetRule(rule))
+		{
+			hashLifeMode = false;
+			redrawGrid = true;
+		}
+	}
+
+	if (!hashLifeMode)
+	{
+		grid->Step(&engine->RasterPool());
+		return;
+	}
+
+	// 'Q' / 'A' = Skip more / fewer generations each step
+	if (InputHandler::Instance().IsKeyPressed('Q'))
+		universe->SetStepLog2(universe->StepLog2() + 1);
+	if (InputHandler::Instance().IsKeyPressed('A'))
+		universe->SetStepLog2(universe->StepLog2() - 1);
+
+	// 'Z' / 'X' = Zoom out / in
+	if (InputHandler::Instance().IsKeyPressed('Z') && zoom < MAX_ZOOM)
+		++zoom;
+	if (InputHandler::Instance().IsKeyPressed('X') && zoom > MIN_ZOOM)
+		--zoom;
+
+	// Arrows = Pan the view
+	double pan = PAN_SPEED * ldexp(1.0, zoom) * Time::Instance().DeltaTime();
+	if (InputHandler::Instance().IsKeyHeld(VK_LEFT))
+		viewX -= pan;
+	if (InputHandler::Instance().IsKeyHeld(VK_RIGHT))
+		viewX += pan;
+	if (InputHandler::Instance().IsKeyHeld(VK_UP))
+		viewY -= pan;
+	if (InputHandler::Instance().IsKeyHeld(VK_DOWN))
+		viewY += pan;
+
+	universe->Step();
+}
 
 /*
- * Reset()
- * Resets the game back to the beginning state.
+ * Draw()
+ * Draws whichever board is running.
  */
-void CellularAutomata::Reset()
+void CellularAutomata::Draw()
 {
-	if (currentState != NULL)
-		delete[] currentState;
-	if (newState != NULL)
-		delete[] newState;
+	if (hashLifeMode)
+		DrawUniverse();
+	else
+		DrawGrid();
+}
 
-	currentState = new bool[screenWidth * screenHeight];
-	newState = new bool[screenWidth * screenHeight];
+/*
+ * DrawGrid()
+ * Draws the grid straight from its packed rows. The screen buffer keeps last frame's cells, so only tiles that changed are drawn again.
+ */
+void CellularAutomata::DrawGrid()
+{
+	CharInfo* cells = engine->ScreenBuffer();
+	int columns = (screenWidth < engine->ScreenWidth()) ? screenWidth : engine->ScreenWidth();
+	int rows = (screenHeight < engine->ScreenHeight()) ? screenHeight : engine->ScreenHeight();
 
-	memset(currentState, 0, sizeof(bool) * screenWidth * screenHeight);
-	memset(newState, 0, sizeof(bool) * screenWidth * screenHeight);
+	const std::vector<int>& changedTiles = grid->ChangedTiles();
+	int regionCount = redrawGrid ? 1 : (int)changedTiles.size();
+	for (int region = 0; region < regionCount; ++region)
+	{
+		int minX = 0, minY = 0, maxX = columns, maxY = rows;
+		if (!redrawGrid)
+		{
+			grid->TileBounds(changedTiles[region], minX, minY, maxX, maxY);
+			maxX = (maxX < columns) ? maxX : columns;
+			maxY = (maxY < rows) ? maxY : rows;
+		}
 
+		for (int y = minY; y < maxY; ++y)
+		{
+			const uint64_t* row = grid->Row(y);
+			CharInfo* cell = cells + (y * engine->ScreenWidth());
+			for (int x = minX; x < maxX; ++x)
+			{
+				bool alive = ((row[x / 64] >> (x % 64)) & 1) != 0;
+				cell[x].Char.UnicodeChar = alive ? PIXEL_SOLID : ' ';
+				cell[x].Attributes = FG_WHITE;
+			}
+		}
+	}
+	redrawGrid = false;
+}
+
+/*
+ * DrawUniverse()
+ * Draws the part of the HashLife universe under the view, shading each character by how much of it is alive when zoomed out.
+ */
+void CellularAutomata::DrawUniverse()
+{
+	// Line the view up with whole characters so each one always covers the same cells
+	int64_t centreX = (int64_t)floor(viewX), centreY = (int64_t)floor(viewY);
+	int64_t left, top;
+	if (zoom >= 0)
+	{
+		left = ((centreX >> zoom) - (screenWidth / 2)) << zoom;
+		top = ((centreY >> zoom) - (screenHeight / 2)) << zoom;
+	}
+	else
+	{
+		left = centreX - ((screenWidth / 2) >> -zoom);
+		top = centreY - ((screenHeight / 2) >> -zoom);
+	}
+	universe->Render(left, top, zoom, screenWidth, screenHeight, coverage);
+
+	CharInfo* cells = engine->ScreenBuffer();
+	int columns = (screenWidth < engine->ScreenWidth()) ? screenWidth : engine->ScreenWidth();
+	int rows = (screenHeight < engine->ScreenHeight()) ? screenHeight : engine->ScreenHeight();
+	for (int y = 0; y < rows; ++y)
+	{
+		CharInfo* cell = cells + (y * engine->ScreenWidth());
+		const float* alive = coverage + (y * screenWidth);
+		for (int x = 0; x < columns; ++x)
+		{
+			short character = ' ';
+			if (alive[x] >= 0.75f)
+				character = PIXEL_SOLID;
+			else if (alive[x] >= 0.5f)
+				character = PIXEL_THREEQUARTER;
+			else if (alive[x] >= 0.25f)
+				character = PIXEL_HALF;
+			else if (alive[x] > 0.0f)
+				character = PIXEL_QUARTER;
+
+			cell[x].Char.UnicodeChar = character;
+			cell[x].Attributes = FG_WHITE;
+		}
+	}
+
+	// Formatted on the stack rather than joined from std::wstrings, which allocated every frame
+	std::string rule = universe->Rule().ToString();
+	wchar_t text[160];
+	int length = swprintf(text, 160, L"Generation %llu  Population %llu  Step 2^%d  Zoom 2^%d  Rule ", (unsigned long long)universe->Generation(),
+						  (unsigned long long)universe->Population(), universe->StepLog2(), zoom);
+	for (size_t i = 0; i < rule.size() && length < 159; ++i)
+		text[length++] = (wchar_t)rule[i];
+	text[length] = L'\0';
+	engine->DrawString(0, 0, text, FG_YELLOW);
+}
+
+/*
+ * Reset()
+ * Resets the game back to the beginning state.
+ */
+void CellularAutomata::Reset()
+{
+	patternIndex = -1;
+	ruleIndex = 0;
+	grid->SetRule(LifeRule());
+	grid->Clear();
 	GenerateAssets();
+	redrawGrid = true;
+
+	viewX = 0.0;
+	viewY = 0.0;
+	zoom = 0;
+	if (hashLifeMode)
+		SeedUniverse();
 }
 
 /*
@@ -100,29 +281,60 @@ void CellularAutomata::Reset()
  */
 void CellularAutomata::GenerateAssets()
 {
-	for (int i = 0; i < screenWidth * screenHeight; ++i)
-		currentState[i] = rand() % 2;
+	for (int y = 0; y < screenHeight; ++y)
+		for (int x = 0; x < screenWidth; ++x)
+			grid->Set(x, y, rand() % 2 == 1);
 }
 
 /*
- * GetNeighbors()
- * Finds out how many neighbors are alive from the 8 that surround the cell at the coordinates given.
- * @param x The x coordinate of the cell to be checked.
- * @param y The y coordinate of the cell to be checked.
- * @return Number of neighbors that are alive.
+ * LoadPattern()
+ * Puts the current pattern in the middle of an empty grid, switching to the pattern's rule if its file gives one,
+ * or fills the grid with a random soup if there is no current pattern. Patterns that fail to load leave an empty grid.
  */
-int CellularAutomata::GetNeighbors(const int& x, const int& y)
+void CellularAutomata::LoadPattern()
 {
-	int count = 0;
-
-	if (x > 0               && y > 0                && currentState[((y - 1) * screenWidth) + (x - 1)]) ++count; // Top Left
-	if (                       y > 0                && currentState[((y - 1) * screenWidth) +  x     ]) ++count; // Top Middle
-	if (x < screenWidth - 1 && y > 0                && currentState[((y - 1) * screenWidth) + (x + 1)]) ++count; // Top Right
-	if (x > 0               &&                         currentState[( y      * screenWidth) + (x - 1)]) ++count; // Middle Left
-	if (x < screenWidth - 1 &&                         currentState[( y      * screenWidth) + (x + 1)]) ++count; // Middle Right
-	if (x > 0               && y < screenHeight - 1 && currentState[((y + 1) * screenWidth) + (x - 1)]) ++count; // Bottom Left
-	if (                       y < screenHeight - 1 && currentState[((y + 1) * screenWidth) +  x     ]) ++count; // Bottom Middle
-	if (x < screenWidth - 1 && y < screenHeight - 1 && currentState[((y + 1) * screenWidth) + (x + 1)]) ++count; // Bottom Right
-
-	return count;
+	grid->Clear();
+	redrawGrid = true;
+
+	if (patternIndex < 0)
+		GenerateAssets();
+	else
+	{
+		LifePattern pattern;
+		if (pattern.LoadFromFile(PATTERN_FILES[patternIndex]))
+		{
+			if (pattern.hasRule)
+				grid->SetRule(pattern.rule);
+
+			int left = (screenWidth - pattern.width) / 2, top = (screenHeight - pattern.height) / 2;
+			for (size_t i = 0; i < pattern.CellCount(); ++i)
+				grid->Set(left + pattern.cellX[i], top + pattern.cellY[i], true);
+		}
+	}
+
+	viewX = 0.0;
+	viewY = 0.0;
+	if (hashLifeMode)
+		SeedUniverse();
+}
+
+/*
+ * SeedUniverse()
+ * Starts the HashLife universe off from the grid's cells and rule, with the middle of the grid at 0, 0.
+ * Rules HashLife can't run (B0) switch back to the grid.
+ */
+void CellularAutomata::SeedUniverse()
+{
+	if (!universe->SetRule(grid->Rule()))
+	{
+		hashLifeMode = false;
+		redrawGrid = true;
+		return;
+	}
+
+	universe->Clear();
+	for (int y = 0; y < screenHeight; ++y)
+		for (int x = 0; x < screenWidth; ++x)
+			if (grid->Get(x, y))
+				universe->Set(x - (screenWidth / 2), y - (screenHeight / 2), true);
 }
\ No newline at end of file
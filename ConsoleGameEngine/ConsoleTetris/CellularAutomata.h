@@ -1,25 +1,43 @@
 #pragma once
 #include "Application.h"
 #include "GameEngine.h"
+#include "HashLife.h"
+#include "LifeGrid.h"
+#include "LifePattern.h"
 
 /*
  * CellularAutomata
  * Implements the logic for Conway's Game of Life
+ * Runs either on a screen sized LifeGrid, or on an unbounded HashLife universe that can skip 2^k generations at a time.
+ * Starts from a random soup, or from one of the RLE / plaintext patterns in the Assets folder, under any B/S rule.
  */
 class CellularAutomata : public Application
 {
 private:
-	bool* currentState;
-	bool* newState;
+	LifeGrid* grid;
+	bool redrawGrid;
+	int patternIndex;
+	int ruleIndex;
+
+	// HashLife
+	HashLife* universe;
+	bool hashLifeMode;
+	float* coverage;
+	double viewX;
+	double viewY;
+	int zoom;
 
 	// Game Logic Functions
 	void GameLogic(void) override;
 	void Draw(void) override;
+	void DrawGrid(void);
+	void DrawUniverse(void);
 	void Reset(void);
+	void LoadPattern(void);
+	void SeedUniverse(void);
 
 	// Misc Functions
 	void GenerateAssets(void) override;
-	int GetNeighbors(const int& x, const int& y);
 
 public:
 	CellularAutomata(GameEngine* engine, int appID, int width = 320, int height = 160, int fontWidth = 4, int fontHeight = 4);
@@ -0,0 +1,18 @@
+#pragma once
+
+namespace Engine { namespace Graphics {
+	/**
+	 * CharInfo
+	 * A single character cell of the screen buffer.
+	 * Laid out the same as the Win32 CHAR_INFO so the console backend can hand the buffer straight to the console.
+	 */
+	struct CharInfo
+	{
+		union
+		{
+			unsigned short UnicodeChar;
+			char AsciiChar;
+		} Char;
+		unsigned short Attributes;
+	};
+} }
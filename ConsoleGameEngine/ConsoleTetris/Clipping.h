@@ -0,0 +1,123 @@
+#pragma once
+
+namespace Engine { namespace Graphics {
+	/**
+	 * ClipVertex
+	 * A point in clip space, before the divide by w, and its brightness and texture coordinates, which are carried along when the point is clipped.
+	 */
+	struct ClipVertex
+	{
+		float x;
+		float y;
+		float z;
+		float w;
+		float shade;
+		float u;
+		float v;
+	};
+
+	// The planes a clip space point can be outside of, as bits of an outcode
+	static const int CLIP_LEFT = 0x01;
+	static const int CLIP_RIGHT = 0x02;
+	static const int CLIP_BOTTOM = 0x04;
+	static const int CLIP_TOP = 0x08;
+	static const int CLIP_NEAR = 0x10;
+	static const int CLIP_FAR = 0x20;
+
+	// The most points a triangle can have after being clipped by all six planes
+	static const int CLIP_MAX_VERTICES = 9;
+
+	/**
+	 * ClipDistance()
+	 * @param vertex The point in clip space.
+	 * @param plane One of the CLIP_ plane bits.
+	 * @param guardBand How far the left, right, top and bottom planes are from the centre of the screen, in half screens (1 is the screen's edge).
+	 * @return How far inside the plane the point is, negative if it is outside.
+	 */
+	inline float ClipDistance(const ClipVertex& vertex, const int& plane, const float& guardBand)
+	{
+		switch (plane)
+		{
+		case CLIP_LEFT:   return vertex.x + (guardBand * vertex.w);
+		case CLIP_RIGHT:  return (guardBand * vertex.w) - vertex.x;
+		case CLIP_BOTTOM: return vertex.y + (guardBand * vertex.w);
+		case CLIP_TOP:    return (guardBand * vertex.w) - vertex.y;
+		case CLIP_NEAR:   return vertex.z;
+		default:          return vertex.w - vertex.z;
+		}
+	}
+
+	/**
+	 * ClipOutcode()
+	 * @param vertex The point in clip space.
+	 * @param guardBand How far the left, right, top and bottom planes are from the centre of the screen, in half screens (1 is the screen's edge).
+	 * @return A CLIP_ bit set for every plane the point is outside of.
+	 */
+	inline int ClipOutcode(const ClipVertex& vertex, const float& guardBand)
+	{
+		float edge = guardBand * vertex.w;
+		return ((vertex.x < -edge) ? CLIP_LEFT : 0) | ((vertex.x > edge) ? CLIP_RIGHT : 0) |
+			   ((vertex.y < -edge) ? CLIP_BOTTOM : 0) | ((vertex.y > edge) ? CLIP_TOP : 0) |
+			   ((vertex.z < 0.0f) ? CLIP_NEAR : 0) | ((vertex.z > vertex.w) ? CLIP_FAR : 0);
+	}
+
+	/**
+	 * ClipPolygon()
+	 * Clips a convex polygon in clip space against a set of planes, one plane after another (Sutherland-Hodgman).
+	 * Clipping before the divide by w means points behind the camera are cut away before they can be projected.
+	 * @param vertices The polygon's points, replaced with the clipped polygon. Must have room for CLIP_MAX_VERTICES.
+	 * @param count The number of points in the polygon.
+	 * @param planes The CLIP_ bits of the planes to clip against - usually the outcodes of the points or'd together.
+	 * @param guardBand How far the left, right, top and bottom planes are from the centre of the screen, in half screens (1 is the screen's edge).
+	 * @return The number of points in the clipped polygon, less than 3 if nothing is left.
+	 */
+	inline int ClipPolygon(ClipVertex* vertices, int count, const int& planes, const float& guardBand)
+	{
+		ClipVertex scratch[CLIP_MAX_VERTICES];
+		ClipVertex* input = vertices;
+		ClipVertex* output = scratch;
+
+		for (int plane = CLIP_LEFT; plane <= CLIP_FAR && count >= 3; plane <<= 1)
+		{
+			if ((planes & plane) == 0)
+				continue;
+
+			int outputCount = 0;
+			ClipVertex previous = input[count - 1];
+			float previousDistance = ClipDistance(previous, plane, guardBand);
+
+			for (int i = 0; i < count; ++i)
+			{
+				ClipVertex current = input[i];
+				float currentDistance = ClipDistance(current, plane, guardBand);
+
+				// Crossing the plane adds the point where the edge meets it
+				if ((previousDistance >= 0.0f) != (currentDistance >= 0.0f))
+				{
+					float t = previousDistance / (previousDistance - currentDistance);
+					output[outputCount++] = { previous.x + ((current.x - previous.x) * t), previous.y + ((current.y - previous.y) * t),
+											  previous.z + ((current.z - previous.z) * t), previous.w + ((current.w - previous.w) * t),
+											  previous.shade + ((current.shade - previous.shade) * t),
+											  previous.u + ((current.u - previous.u) * t), previous.v + ((current.v - previous.v) * t) };
+				}
+
+				if (currentDistance >= 0.0f)
+					output[outputCount++] = current;
+
+				previous = current;
+				previousDistance = currentDistance;
+			}
+
+			ClipVertex* swap = input;
+			input = output;
+			output = swap;
+			count = outputCount;
+		}
+
+		if (input != vertices)
+			for (int i = 0; i < count; ++i)
+				vertices[i] = input[i];
+
+		return count;
+	}
+} }
\ No newline at end of file
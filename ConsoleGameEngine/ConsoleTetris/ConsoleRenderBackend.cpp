@@ -0,0 +1,114 @@
+#include "ConsoleRenderBackend.h"
+#ifdef _WIN32
+
+using namespace Engine::Graphics;
+
+static_assert(sizeof(CharInfo) == sizeof(CHAR_INFO), "CharInfo must match the layout of CHAR_INFO");
+
+/**
+ * Constructor
+ */
+ConsoleRenderBackend::ConsoleRenderBackend() : console(NULL), windowRect({ 0, 0, 1, 1 }), screenWidth(0), screenHeight(0) { }
+
+/**
+ * Destructor
+ */
+ConsoleRenderBackend::~ConsoleRenderBackend()
+{
+	if (console != NULL)
+		CloseHandle(console);
+}
+
+/**
+ * SetupWindow()
+ * Sets the size of the console and the font used.
+ * @param width The width of the console in characters.
+ * @param height The height of the console in characters.
+ * @param fontWidth The width of the characters in pixels.
+ * @param fontHeight The height of the characters in pixels.
+ */
+void ConsoleRenderBackend::SetupWindow(const int& width, const int& height, const int& fontWidth, const int& fontHeight)
+{
+	// Checks if this is the first time the window is setup.
+	if (console == NULL)
+	{
+		// TODO: Error check console handle
+		console = GetStdHandle(STD_OUTPUT_HANDLE);
+	}
+
+	screenWidth = width;
+	screenHeight = height;
+
+	// Change console visualsize to be the minimum so Screen Buffer can shrink.
+	windowRect = { 0, 0, 1, 1 };
+	SetConsoleWindowInfo(console, TRUE, &windowRect); // TODO: Error check
+
+	// Set size of Screen Buffer.
+	COORD screenDimentions = { (short)screenWidth, (short)screenHeight };
+	SetConsoleScreenBufferSize(console, screenDimentions); // TODO: Error check
+
+	// Set Screen Buffer to console.
+	SetConsoleActiveScreenBuffer(console); // TODO: Error check
+
+	// Set the font size.
+	CONSOLE_FONT_INFOEX cfi;
+	cfi.cbSize = sizeof(cfi);
+	cfi.nFont = 0;
+	cfi.dwFontSize.X = fontWidth;
+	cfi.dwFontSize.Y = fontHeight;
+	cfi.FontFamily = FF_DONTCARE;
+	cfi.FontWeight = FW_NORMAL;
+	wcscpy_s(cfi.FaceName, L"Consolas");
+	SetCurrentConsoleFontEx(console, false, &cfi); // TODO: Error check
+
+	// Checks if the dimentions exceed the maximum allows window size. 
+	CONSOLE_SCREEN_BUFFER_INFO screenBufferInfo;
+	GetConsoleScreenBufferInfo(console, &screenBufferInfo); // TODO: Error check
+	// TODO: Check if window size exceeds the maximum allowed dimentions
+	// if (screenHeight > screenBufferInfo.Y)
+	//		THROW ERROR
+	// if (screenWidth > screenBufferInfo.X)
+	//		THROW ERROR
+
+	// Sets the window size
+	windowRect = { 0, 0, (short)(screenWidth - 1), (short)(screenHeight - 1) };
+	SetConsoleWindowInfo(console, TRUE, &windowRect); // TODO: Error check
+}
+
+/**
+ * Draw()
+ * Takes an array of characters and draws the parts of it that have changed to the console.
+ * Spans on consecutive rows are merged into a single rectangle so a small moving shape only costs one write.
+ * @param title The name of the program to be displayed on the top bar.
+ * @param characterArray The array of characters that will be drawn to the console.
+ * @param spans The changed spans of each dirty row, in row order.
+ * @param spanCount The number of spans given.
+ * @param stats The timings of the frame to show on the top bar.
+ */
+void ConsoleRenderBackend::Draw(const wchar_t* title, const CharInfo* characterArray, const DirtySpan* spans, const int& spanCount, const FrameStats& stats)
+{
+	wchar_t s[256];
+	swprintf_s(s, 256, L"%s - FPS: %3.2f - Run: %3.2f - Rend: %3.2f - Cells: %d - Allocs: %d", title, stats.fps, stats.runTime, stats.renderTime, stats.changedCells, stats.allocations);
+	SetConsoleTitle(s);
+
+	const CHAR_INFO* consoleArray = reinterpret_cast<const CHAR_INFO*>(characterArray);
+
+	int i = 0;
+	while (i < spanCount)
+	{
+		SMALL_RECT region = { spans[i].minX, spans[i].row, spans[i].maxX, spans[i].row };
+
+		// Grow the region down while the next span is on the following row
+		for (++i; i < spanCount && spans[i].row == region.Bottom + 1; ++i)
+		{
+			region.Bottom = spans[i].row;
+			if (spans[i].minX < region.Left)
+				region.Left = spans[i].minX;
+			if (spans[i].maxX > region.Right)
+				region.Right = spans[i].maxX;
+		}
+
+		WriteConsoleOutput(console, consoleArray, { (short)screenWidth, (short)screenHeight }, { region.Left, region.Top }, &region);
+	}
+}
+#endif
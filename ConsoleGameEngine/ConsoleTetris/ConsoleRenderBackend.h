@@ -0,0 +1,29 @@
+#pragma once
+#ifdef _WIN32
+#include <Windows.h>
+
+#include "RenderBackend.h"
+
+namespace Engine { namespace Graphics {
+	/**
+	 * ConsoleRenderBackend
+	 * Draws the screen buffer to the Windows console.
+	 */
+	class ConsoleRenderBackend : public RenderBackend
+	{
+	private:
+		HANDLE console;
+		SMALL_RECT windowRect;
+
+		int screenWidth;
+		int screenHeight;
+
+	public:
+		ConsoleRenderBackend(void);
+		~ConsoleRenderBackend(void);
+
+		void SetupWindow(const int& width, const int& height, const int& fontWidth, const int& fontHeight) override;
+		void Draw(const wchar_t* title, const CharInfo* characterArray, const DirtySpan* spans, const int& spanCount, const FrameStats& stats) override;
+	};
+} }
+#endif
@@ -4,30 +4,62 @@
 namespace Engine { namespace Physics {
 	/**
 	 * FVector2
+	 * A plain value type - everything is defined here so it can be inlined, and used in constant expressions where possible.
 	 */
 	struct FVector2
 	{
 		float x;
 		float y;
 
-		FVector2(void);
-		FVector2(float x, float y);
+		constexpr FVector2(void) : x(0.0f), y(0.0f) { }
+		constexpr FVector2(float x, float y) : x(x), y(y) { }
 
 		// Functions
-		float Magnitude(void) const;
-		FVector2 Normalized(void) const;
+		float Magnitude(void) const { return sqrtf((x * x) + (y * y)); }
+
+		FVector2 Normalized(void) const
+		{
+			float mag = Magnitude();
+			if (mag == 0.0f)
+				return FVector2(0.0f, 0.0f);
+			else
+				return *this / mag;
+		}
 
 		// Math Operators
-		FVector2 operator+(const FVector2& other) const;
-		FVector2 operator-(const FVector2& other) const;
-		FVector2 operator*(const float& other) const;
-		FVector2 operator/(const float& other) const;
-		FVector2 operator=(const FVector2& other);
-		FVector2 operator+=(const FVector2& other);
-		FVector2 operator-=(const FVector2& other);
-		FVector2 operator*=(const float& other);
-		FVector2 operator/=(const float& other);
-
-		bool operator==(const FVector2& other) const;
+		constexpr FVector2 operator+(const FVector2& other) const { return FVector2(x + other.x, y + other.y); }
+		constexpr FVector2 operator-(const FVector2& other) const { return FVector2(x - other.x, y - other.y); }
+		constexpr FVector2 operator*(const float& other) const { return FVector2(x * other, y * other); }
+		constexpr FVector2 operator/(const float& other) const { return FVector2(x / other, y / other); }
+
+		constexpr FVector2& operator+=(const FVector2& other)
+		{
+			x += other.x;
+			y += other.y;
+			return *this;
+		}
+
+		constexpr FVector2& operator-=(const FVector2& other)
+		{
+			x -= other.x;
+			y -= other.y;
+			return *this;
+		}
+
+		constexpr FVector2& operator*=(const float& other)
+		{
+			x *= other;
+			y *= other;
+			return *this;
+		}
+
+		constexpr FVector2& operator/=(const float& other)
+		{
+			x /= other;
+			y /= other;
+			return *this;
+		}
+
+		constexpr bool operator==(const FVector2& other) const { return (x == other.x && y == other.y); }
 	};
 } }
\ No newline at end of file
@@ -1,12 +1,12 @@
 #pragma once
 #include <math.h>
 
-#include "Matrix4x4.h"
-
 namespace Engine {
 	namespace Physics {
 		/**
 		 * FVector3
+		 * A plain value type - everything is defined here so it can be inlined, and used in constant expressions where possible.
+		 * Transforming by a Matrix4x4 is declared in Matrix4x4.h.
 		 */
 		struct FVector3
 		{
@@ -14,34 +14,70 @@ namespace Engine {
 			float y;
 			float z;
 
-			FVector3(void);
-			FVector3(float x, float y, float z);
+			constexpr FVector3(void) : x(0.0f), y(0.0f), z(0.0f) { }
+			constexpr FVector3(float x, float y, float z) : x(x), y(y), z(z) { }
 
 			// Functions
-			float Magnitude(void) const;
-			FVector3 Normalized(void) const;
+			float Magnitude(void) const { return sqrtf((x * x) + (y * y) + (z * z)); }
+
+			FVector3 Normalized(void) const
+			{
+				float mag = Magnitude();
+				if (mag == 0.0f)
+					return FVector3(0.0f, 0.0f, 0.0f);
+				else
+					return *this / mag;
+			}
 
 			// Math Operators
-			FVector3 operator+(const FVector3& other) const;
-			FVector3 operator-(const FVector3& other) const;
-			FVector3 operator*(const float& other) const;
-			FVector3 operator*(const Matrix4x4& matrix) const;
-			FVector3 operator/(const float& other) const;
-			FVector3& operator=(const FVector3& other);
-			FVector3& operator+=(const FVector3& other);
-			FVector3& operator-=(const FVector3& other);
-			FVector3& operator*=(const float& other);
-			FVector3& operator*=(const Matrix4x4& matrix);
-			FVector3& operator/=(const float& other);
-
-			bool operator==(const FVector3& other) const;
+			constexpr FVector3 operator+(const FVector3& other) const { return FVector3(x + other.x, y + other.y, z + other.z); }
+			constexpr FVector3 operator-(const FVector3& other) const { return FVector3(x - other.x, y - other.y, z - other.z); }
+			constexpr FVector3 operator*(const float& other) const { return FVector3(x * other, y * other, z * other); }
+			constexpr FVector3 operator/(const float& other) const { return FVector3(x / other, y / other, z / other); }
+
+			constexpr FVector3& operator+=(const FVector3& other)
+			{
+				x += other.x;
+				y += other.y;
+				z += other.z;
+				return *this;
+			}
+
+			constexpr FVector3& operator-=(const FVector3& other)
+			{
+				x -= other.x;
+				y -= other.y;
+				z -= other.z;
+				return *this;
+			}
+
+			constexpr FVector3& operator*=(const float& other)
+			{
+				x *= other;
+				y *= other;
+				z *= other;
+				return *this;
+			}
+
+			constexpr FVector3& operator/=(const float& other)
+			{
+				x /= other;
+				y /= other;
+				z /= other;
+				return *this;
+			}
+
+			constexpr bool operator==(const FVector3& other) const { return (x == other.x && y == other.y && z == other.z); }
 
 			// Cross and Dot Product
-			FVector3 CrossProduct(const FVector3& other) const;
-			float DotProduct(const FVector3& other) const;
-			
-			// Misc Functions
-			FVector3 IntersectPlane(FVector3& normal, const FVector3& lineStart, const FVector3& lineEnd);
+			constexpr FVector3 CrossProduct(const FVector3& other) const
+			{
+				return FVector3(y * other.z - z * other.y,
+								z * other.x - x * other.z,
+								x * other.y - y * other.x);
+			}
+
+			constexpr float DotProduct(const FVector3& other) const { return (x * other.x) + (y * other.y) + (z * other.z); }
 		};
 	}
 }
\ No newline at end of file
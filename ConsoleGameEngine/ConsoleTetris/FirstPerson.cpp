@@ -1,5 +1,22 @@
+#include <cfloat>
+
 #include "FirstPerson.h"
 
+// The closest a wall is drawn as being, so walls right in front of the player don't become infinitely tall
+static const float MIN_WALL_DISTANCE = 0.05f;
+
+// How many neighbouring columns each thread draws at a time - wide enough that threads rarely write to the same cache line
+static const int COLUMNS_PER_JOB = 32;
+
+// One map cell in the 16.16 fixed point the floor and ceiling are stepped across in
+static const float FLOOR_FIXED_ONE = 65536.0f;
+
+// The closest an object is drawn, so ones the player is standing in don't fill the screen
+static const float MIN_OBJECT_DISTANCE = 0.5f;
+
+// One texel in the 16.16 fixed point billboards are stepped across in
+static const float OBJECT_FIXED_ONE = 65536.0f;
+
 /*
  * Constructor (Default Map)
  * @param screenBuffer A pointer to the screenbuffer to be able to draw to.
@@ -11,7 +28,7 @@
  * @param fontHeight Pixel height of the font.
  */
 FirstPerson::FirstPerson(GameEngine* engine, int appID, int width, int height, int fontWidth, int fontHeight) : Application(engine, appID, width, height, fontWidth, fontHeight),
-	mapWidth(32), mapHeight(32), player(2.0f, 2.0f), direction(sinf(playerA), cosf(playerA)), moveVelocity(0.0f, 0.0f), playerA(0.0f) 
+	mapWidth(32), mapHeight(32), player(2.0f, 2.0f), direction(sinf(playerA), cosf(playerA)), moveVelocity(0.0f, 0.0f), playerA(0.0f), floorCasting(true)
 {
 	GenerateAssets();
 }
@@ -30,7 +47,7 @@ FirstPerson::FirstPerson(GameEngine* engine, int appID, int width, int height, i
  * @param map The map to be created.
  */
 FirstPerson::FirstPerson(GameEngine* engine, int appID, int width, int height, int fontWidth, int fontHeight, int mapWidth, int mapHeight, std::wstring map) : Application(engine, appID, width, height, fontWidth, fontHeight), 
-	mapWidth(mapWidth), mapHeight(mapHeight), map(map), player(2.0f, 2.0f), direction(sinf(playerA), cosf(playerA)), moveVelocity(0.0f, 0.0f), playerA(0.0f) { }
+	mapWidth(mapWidth), mapHeight(mapHeight), map(map), player(2.0f, 2.0f), direction(sinf(playerA), cosf(playerA)), moveVelocity(0.0f, 0.0f), playerA(0.0f), floorCasting(true) { }
 
 /**
  * Destructor
@@ -41,8 +58,14 @@ FirstPerson::~FirstPerson()
 		delete wallSprite;
 	if (lampSprite != nullptr)
 		delete lampSprite;
+	if (floorSprite != nullptr)
+		delete floorSprite;
+	if (ceilingSprite != nullptr)
+		delete ceilingSprite;
 	if (depthBuffer != nullptr)
 		delete[] depthBuffer;
+	if (rowDistances != nullptr)
+		delete[] rowDistances;
 }
 
 /*
@@ -123,6 +146,22 @@ void FirstPerson::GameLogic()
 			player -= moveVelocity;
 	}
 
+	// 'F' = Toggle Textured Floor And Ceiling
+	if (InputHandler::Instance().IsKeyPressed('F'))
+		floorCasting = !floorCasting;
+
+	// Update Object Physics - anything that flies into a wall or off the map is removed
+	for (Object& object : objects)
+	{
+		object.position += object.velocity * Time::Instance().DeltaTime();
+
+		int cellX = (int)floorf(object.position.x);
+		int cellY = (int)floorf(object.position.y);
+		if (cellX < 0 || cellX >= mapWidth || cellY < 0 || cellY >= mapHeight || map[(cellY * mapWidth) + cellX] == '#')
+			object.remove = true;
+	}
+	objects.erase(std::remove_if(objects.begin(), objects.end(), [](const Object& o) { return o.remove; }), objects.end());
+
 	// Fire Projectile
 	if (InputHandler::Instance().IsKeyPressed(VK_SPACE))
 	{
@@ -142,145 +181,287 @@ void FirstPerson::GameLogic()
  */
 void FirstPerson::Draw()
 {
-	for (int x = 0; x < screenWidth; ++x)
+	// The rays through the left edge of the screen and each column after it. They reach one unit straight ahead of the player,
+	// and every ray's direction is a step along the line between the edges, so rays and floor rows are both linear walks
+	float halfFov = fov / 2.0f;
+	leftRay = FVector2(sinf(playerA - halfFov), cosf(playerA - halfFov)) / cosf(halfFov);
+	rayStep = ((FVector2(sinf(playerA + halfFov), cosf(playerA + halfFov)) / cosf(halfFov)) - leftRay) / (float)screenWidth;
+
+	// Every column is cast and drawn on its own, so blocks of them are shared out across the engine's threads,
+	// each writing straight into its own columns of the screen and depth buffer
+	CharInfo* cells = engine->ScreenBuffer();
+	int columns = (screenWidth < engine->ScreenWidth()) ? screenWidth : engine->ScreenWidth();
+	int rows = (screenHeight < engine->ScreenHeight()) ? screenHeight : engine->ScreenHeight();
+	auto drawColumns = [&](int block)
 	{
-		// For each column, calculate the projected ray angle into world space
-		float rayAngle = (playerA - (fov / 2.0f)) + (((float)x / (float)screenWidth) * fov);
+		int first = block * COLUMNS_PER_JOB;
+		int last = (first + COLUMNS_PER_JOB < columns) ? first + COLUMNS_PER_JOB - 1 : columns - 1;
+		DrawColumns(cells, first, last, rows);
+	};
+	engine->RasterPool().ParallelFor((columns + COLUMNS_PER_JOB - 1) / COLUMNS_PER_JOB, drawColumns);
 
-		float stepSize = 0.05f;
-		float distanceToWall = 0.0f;
-		bool hitWall = false;
-		bool hitBoundry = false;
+	// Objects are tested against every column's depth, so are only drawn once all of the columns are done
+	DrawObjects(cells, columns, rows);
 
-		FVector2 eye = FVector2(sinf(rayAngle), cosf(rayAngle)); // Unit Vector for ray in player space
-		float sampleX = 0.0f;
+	// Display Map
+	for (int x = 0; x < mapWidth; ++x)
+		for (int y = 0; y < mapHeight; ++y)
+			engine->DrawChar(x, y, map[(y * mapWidth) + x]);
 
-		while (!hitWall && distanceToWall < depthOfField)
-		{
-			distanceToWall += stepSize;
+	engine->DrawChar((int)player.x, (int)player.y + 1, 'P');
+}
 
-			// Position of ray hit on the map
-			int testX = (int)(player.x + (eye.x * distanceToWall));
-			int testY = (int)(player.y + (eye.y * distanceToWall));
+/*
+ * DrawObjects()
+ * Draws every object as a billboard - a sprite that always faces the player. Objects are taken into camera space, where
+ * anything behind the player, too far away or off the side of the screen is dropped, and the rest are drawn furthest first
+ * so nearer ones cover them. Each is drawn a column at a time, only where it is in front of that column's wall.
+ * @param cells The engine's screen buffer.
+ * @param columns The number of columns on the screen.
+ * @param rows The number of rows on the screen.
+ */
+void FirstPerson::DrawObjects(CharInfo* cells, const int& columns, const int& rows)
+{
+	int stride = engine->ScreenWidth();
+	FVector2 right = FVector2(direction.y, -direction.x);
+	float halfWidth = (float)screenWidth * 0.5f;
+	float projection = halfWidth / tanf(fov / 2.0f);
+
+	// Camera Space Culling - depth is straight ahead of the player, the same as the walls' depth
+	std::vector<Billboard, ArenaAllocator<Billboard>> billboards((ArenaAllocator<Billboard>(engine->Arena())));
+	billboards.reserve(objects.size());
+	for (const Object& object : objects)
+	{
+		FVector2 offset = object.position - player;
+		float depth = (offset.x * direction.x) + (offset.y * direction.y);
+		if (depth < MIN_OBJECT_DISTANCE || depth >= depthOfField)
+			continue;
+
+		// Sized the same way as walls, so an object as tall as a wall fills the screen to the same height
+		float height = (2.0f * (float)screenHeight) / depth;
+		float width = height * ((float)object.sprite->TexelWidth() / (float)object.sprite->TexelHeight());
+		float centre = halfWidth + ((((offset.x * right.x) + (offset.y * right.y)) / depth) * projection);
+		if (centre + (width * 0.5f) < 0.0f || centre - (width * 0.5f) >= (float)columns)
+			continue;
+
+		billboards.push_back({ depth, centre, width, height, object.sprite });
+	}
 
-			// Test if ray is out of bounds
-			if (testX < 0 || testX >= mapWidth || testY < 0 || testY >= mapHeight)
-			{
-				hitWall = true;					// Just set distance to maximum depth
-				distanceToWall = depthOfField;
-			}
-			else
+	// Back To Front
+	std::sort(billboards.begin(), billboards.end(), [](const Billboard& a, const Billboard& b) { return a.depth > b.depth; });
+
+	for (const Billboard& billboard : billboards)
+	{
+		const short* pixels = billboard.sprite->Pixels();
+		const short* colours = billboard.sprite->Colours();
+		int textureWidth = billboard.sprite->TexelWidth();
+		int textureHeight = billboard.sprite->TexelHeight();
+
+		// The cells the sprite covers, kept on screen, and where in the sprite the first of them samples in 16.16 fixed point
+		float left = billboard.centre - (billboard.width * 0.5f);
+		float top = ((float)screenHeight * 0.5f) - (billboard.height * 0.5f);
+		int firstColumn = (int)fmaxf(ceilf(left - 0.5f), 0.0f);
+		int lastColumn = (int)fminf(ceilf(left + billboard.width - 0.5f) - 1.0f, (float)columns - 1.0f);
+		int firstRow = (int)fmaxf(ceilf(top - 0.5f), 0.0f);
+		int lastRow = (int)fminf(ceilf(top + billboard.height - 0.5f) - 1.0f, (float)rows - 1.0f);
+
+		int stepU = (int)(((float)textureWidth / billboard.width) * OBJECT_FIXED_ONE);
+		int stepV = (int)(((float)textureHeight / billboard.height) * OBJECT_FIXED_ONE);
+		int firstU = (int)((((float)firstColumn + 0.5f) - left) * ((float)textureWidth / billboard.width) * OBJECT_FIXED_ONE);
+		int firstV = (int)((((float)firstRow + 0.5f) - top) * ((float)textureHeight / billboard.height) * OBJECT_FIXED_ONE);
+		int maxU = (textureWidth << 16) - 1;
+		int maxV = (textureHeight << 16) - 1;
+
+		int u = firstU;
+		for (int x = firstColumn; x <= lastColumn; ++x, u += stepU)
+		{
+			// Hidden behind this column's wall
+			if (depthBuffer[x] <= billboard.depth)
+				continue;
+
+			const short* pixelColumn = pixels + (((u < maxU) ? u : maxU) >> 16);
+			const short* colourColumn = colours + (((u < maxU) ? u : maxU) >> 16);
+			CharInfo* cell = cells + (firstRow * stride) + x;
+			int v = firstV;
+			for (int y = firstRow; y <= lastRow; ++y, v += stepV, cell += stride)
 			{
-				if (map[(testY * mapWidth) + testX] == '#') // Ray is inbounds so test to see if ray cell is a wall block
+				int texel = (((v < maxV) ? v : maxV) >> 16) * textureWidth;
+				if (pixelColumn[texel] != 0)
 				{
-					hitWall = true;
+					cell->Char.UnicodeChar = pixelColumn[texel];
+					cell->Attributes = colourColumn[texel];
+				}
+			}
+		}
+	}
+}
 
-					float cellMidX = (float)testX + 0.5f;
-					float cellMidY = (float)testY + 0.5f;
+/*
+ * DrawColumns()
+ * Casts the rays for a block of columns and draws their walls, then their floor and ceiling, straight into the screen buffer.
+ * Only writes to its own columns of the screen and depth buffer, so blocks can be drawn at the same time.
+ * @param cells The engine's screen buffer.
+ * @param first The leftmost column to draw.
+ * @param last The rightmost column to draw.
+ * @param rows The number of rows on the screen.
+ */
+void FirstPerson::DrawColumns(CharInfo* cells, const int& first, const int& last, const int& rows)
+{
+	int stride = engine->ScreenWidth();
 
-					float testPointX = player.x + eye.x * distanceToWall;
-					float testPointY = player.y + eye.y * distanceToWall;
+	// The rows each column's wall covers, from wallStarts up to but not including wallEnds
+	int wallStarts[COLUMNS_PER_JOB];
+	int wallEnds[COLUMNS_PER_JOB];
 
-					float testAngle = atan2f((testPointY - cellMidY), (testPointX - cellMidX));
+	for (int x = first; x <= last; ++x)
+	{
+		FVector2 ray = leftRay + (rayStep * (float)x);
 
-					// Get X sample position.
-					if (testAngle >= (-PI * 0.25f) && testAngle < (PI * 0.25f))
-						sampleX = testPointY - (float)testY;
-					if (testAngle >= (PI * 0.25f) && testAngle < (PI * 0.75f))
-						sampleX = testPointX - (float)testX;
-					if (testAngle < (-PI * 0.25f) && testAngle >= (-PI * 0.75f))
-						sampleX = testPointX - (float)testX;
-					if (testAngle >= (PI * 0.75f) || testAngle < (-PI * 0.75f))
-						sampleX = testPointY - (float)testY;
-				}
-			}
-		}
+		// The ray's length is one unit straight ahead, so its distance is already corrected for fisheye
+		float distanceToWall = depthOfField;
+		float sampleX = 0.0f;
+		bool hitWall = CastRay(ray, distanceToWall, sampleX);
+		float projectedDistance = fmaxf(distanceToWall, MIN_WALL_DISTANCE);
 
 		// Calculate distance to ceiling and floor
-		int ceiling = (float)(screenHeight / 2.0) - (screenHeight / ((float)distanceToWall));
+		int ceiling = (float)(screenHeight / 2.0) - (screenHeight / projectedDistance);
 		int floor = screenHeight - ceiling;
 
-		// Update depth buffer
+		// Update depth buffer with the distance straight ahead, which is what objects are compared against
 		depthBuffer[x] = distanceToWall;
 
-		for (int y = 0; y < screenHeight; ++y)
+		int wallStart = (ceiling + 1 < 0) ? 0 : ((ceiling + 1 > rows) ? rows : ceiling + 1);
+		int wallEnd = (floor + 1 < wallStart) ? wallStart : ((floor + 1 > rows) ? rows : floor + 1);
+		wallStarts[x - first] = wallStart;
+		wallEnds[x - first] = wallEnd;
+
+		// Wall, textured top to bottom
+		CharInfo* cell = cells + (wallStart * stride) + x;
+		float sampleStep = 1.0f / ((float)floor - (float)ceiling);
+		for (int y = wallStart; y < wallEnd; ++y, cell += stride)
 		{
-			if (y <= ceiling)
-				engine->DrawChar(x, y, ' ');
-			else if (y > ceiling && y <= floor)
+			if (hitWall)
 			{
-				if (distanceToWall < depthOfField)
-				{
-					float sampleY = ((float)y - (float)ceiling) / ((float)floor - (float)ceiling);
-					engine->DrawChar(x, y, wallSprite->SamplePixel(sampleX, sampleY), wallSprite->SampleColour(sampleX, sampleY));
-				}
-				else
-					engine->DrawChar(x, y, ' ');
-
+				float sampleY = ((float)y - (float)ceiling) * sampleStep;
+				cell->Char.UnicodeChar = wallSprite->SamplePixel(sampleX, sampleY);
+				cell->Attributes = wallSprite->SampleColour(sampleX, sampleY);
 			}
 			else
-				engine->DrawChar(x, y, PIXEL_SOLID, FG_DARK_GREEN);
+			{
+				cell->Char.UnicodeChar = ' ';
+				cell->Attributes = FG_WHITE;
+			}
 		}
 	}
 
-	// Draw Objects
-	for (auto &object : objects)
+	// Floor and ceiling, a row at a time around the walls
+	for (int y = 0; y < rows; ++y)
 	{
-		// Update Object Physics
-		object.position += object.velocity * Time::Instance().DeltaTime();
-
-		// Object Collision
-		if (map[((int)object.position.x * mapWidth) + (int)object.position.y] == '#')
-			object.remove = true;
-
-		FVector2 vec = FVector2(object.position.x - player.x, object.position.y - player.y);
-		float distanceFromPlayer = vec.Magnitude();
+		CharInfo* row = cells + (y * stride);
+		bool isFloor = (float)y + 0.5f > (float)screenHeight / 2.0f;
 
-		float objectAngle = atan2f(direction.y, direction.x) - atan2f(vec.y, vec.x);
-		if (objectAngle < -PI)
-			objectAngle += 2.0f * PI;
-		if (objectAngle > PI)
-			objectAngle -= 2.0f * PI;
-
-		bool isInPlayerFOV = fabs(objectAngle < fov / 2.0f);
-
-		if (isInPlayerFOV && distanceFromPlayer >= 0.5f && distanceFromPlayer < depthOfField)
+		if (!floorCasting || rowDistances[y] >= depthOfField)
 		{
-			float objectCeiling = (float)(screenHeight / 2.0f) - screenHeight / (float)(distanceFromPlayer);
-			float objectFloor = screenHeight - objectCeiling;
-			float objectHeight = objectFloor - objectCeiling;
-			float objectAspectRatio = (float)(object.sprite->Height()) / (float)(object.sprite->Width());
-			float objectWidth = objectHeight / objectAspectRatio;
-			float middleOfObject = (0.5f * (objectAngle / (fov / 2.0f)) + 0.5f) * (float)screenWidth;
-
-			for (float x = 0; x < objectWidth; ++x)
+			short character = isFloor ? PIXEL_SOLID : ' ';
+			short colour = isFloor ? FG_DARK_GREEN : FG_WHITE;
+			for (int x = first; x <= last; ++x)
 			{
-				for (float y = 0; y < objectHeight; ++y)
+				if (y < wallStarts[x - first] || y >= wallEnds[x - first])
 				{
-					FVector2 sample = FVector2(x / objectWidth, y / objectHeight);
-
-					short character = object.sprite->SamplePixel(sample.x, sample.y);
-					int objectColumn = (int)(middleOfObject + x - (objectWidth / 2.0f));
-					if (objectColumn >= 0 && objectColumn < screenWidth && character != 0 && depthBuffer[objectColumn] >= distanceFromPlayer)
-					{
-						engine->DrawChar(objectColumn, objectCeiling + y, 
-							character, object.sprite->SampleColour(sample.x, sample.y));
-						depthBuffer[objectColumn] = distanceFromPlayer;
-					}
+					row[x].Char.UnicodeChar = character;
+					row[x].Attributes = colour;
 				}
 			}
+			continue;
+		}
+
+		// Where this row meets the floor or ceiling under each column moves by the same amount from one column to the next,
+		// so it is stepped in 16.16 fixed point, where the whole part is the map cell and the fraction where in it to sample
+		const Sprite* texture = isFloor ? floorSprite : ceilingSprite;
+		const short* pixels = texture->Pixels();
+		const short* colours = texture->Colours();
+		unsigned int textureWidth = (unsigned int)texture->TexelWidth();
+		unsigned int textureHeight = (unsigned int)texture->TexelHeight();
+
+		float distance = rowDistances[y];
+		FVector2 start = player + ((leftRay + (rayStep * (float)first)) * distance);
+		FVector2 step = rayStep * distance;
+		unsigned int pointX = (unsigned int)(int)(start.x * FLOOR_FIXED_ONE);
+		unsigned int pointY = (unsigned int)(int)(start.y * FLOOR_FIXED_ONE);
+		unsigned int stepX = (unsigned int)(int)(step.x * FLOOR_FIXED_ONE);
+		unsigned int stepY = (unsigned int)(int)(step.y * FLOOR_FIXED_ONE);
+
+		for (int x = first; x <= last; ++x, pointX += stepX, pointY += stepY)
+		{
+			if (y >= wallStarts[x - first] && y < wallEnds[x - first])
+				continue;
+
+			unsigned int texel = ((((pointY & 0xFFFF) * textureHeight) >> 16) * textureWidth) + (((pointX & 0xFFFF) * textureWidth) >> 16);
+			row[x].Char.UnicodeChar = pixels[texel];
+			row[x].Attributes = colours[texel];
 		}
 	}
+}
+
+/*
+ * CastRay()
+ * Follows a ray from the player through the map one cell at a time (a digital differential analyser), stepping across whichever
+ * grid line, vertical or horizontal, the ray reaches next. Every cell the ray passes through is looked at exactly once, and the
+ * distance to the grid line it entered a wall through is exact, as is which side of the wall it hit.
+ * @param eye The direction of the ray.
+ * @param distance Set to how far along the ray the wall is, in multiples of the ray's length, or depthOfField if none is hit before then.
+ * @param sampleX Set to how far across the face of the wall the ray hit it, from 0.0f to 1.0f.
+ * @return True if a wall was hit within depthOfField.
+ */
+bool FirstPerson::CastRay(const FVector2& eye, float& distance, float& sampleX) const
+{
+	int cellX = (int)player.x;
+	int cellY = (int)player.y;
+
+	// How far along the ray it is between grid lines in each direction, and to the first ones
+	float deltaX = (eye.x != 0.0f) ? fabsf(1.0f / eye.x) : FLT_MAX;
+	float deltaY = (eye.y != 0.0f) ? fabsf(1.0f / eye.y) : FLT_MAX;
+	int stepX = (eye.x < 0.0f) ? -1 : 1;
+	int stepY = (eye.y < 0.0f) ? -1 : 1;
+	float nextX = (eye.x < 0.0f) ? (player.x - (float)cellX) * deltaX : ((float)(cellX + 1) - player.x) * deltaX;
+	float nextY = (eye.y < 0.0f) ? (player.y - (float)cellY) * deltaY : ((float)(cellY + 1) - player.y) * deltaY;
+
+	while (true)
+	{
+		// Cross whichever grid line is closer
+		bool crossedX = nextX < nextY;
+		float crossing = crossedX ? nextX : nextY;
+		if (crossing >= depthOfField)
+			break;
 
-	// Remove Dead Objects
-	objects.remove_if([](Object &o) { return o.remove; });
+		if (crossedX)
+		{
+			cellX += stepX;
+			nextX += deltaX;
+		}
+		else
+		{
+			cellY += stepY;
+			nextY += deltaY;
+		}
 
-	// Display Map
-	for (int x = 0; x < mapWidth; ++x)
-		for (int y = 0; y < mapHeight; ++y)
-			engine->DrawChar(x, y, map[(y * mapWidth) + x]);
+		// Test if ray is out of bounds
+		if (cellX < 0 || cellX >= mapWidth || cellY < 0 || cellY >= mapHeight)
+			break;
 
-	engine->DrawChar((int)player.x, (int)player.y + 1, 'P');
+		if (map[(cellY * mapWidth) + cellX] == '#')
+		{
+			distance = crossing;
+
+			// East and west faces run along y, north and south faces along x
+			sampleX = crossedX ? (player.y + (eye.y * crossing)) - (float)cellY : (player.x + (eye.x * crossing)) - (float)cellX;
+			sampleX = fminf(fmaxf(sampleX, 0.0f), 1.0f);
+			return true;
+		}
+	}
+
+	distance = depthOfField;
+	return false;
 }
 
 /*
@@ -346,5 +527,24 @@ void FirstPerson::GenerateAssets()
 		{ FVector2(3.5f, 10.5f), FVector2(0.0f, 0.0f), false, lampSprite }
 	};
 
+	floorSprite = new Sprite(L"../Assets/Path.spr");
+
+	// Ceiling panels - dark tiles with a lighter edge
+	ceilingSprite = new Sprite(8, 8);
+	for (int y = 0; y < 8; ++y)
+	{
+		for (int x = 0; x < 8; ++x)
+		{
+			bool edge = (x == 0 || y == 0);
+			ceilingSprite->SetPixel(x, y, edge ? PIXEL_SOLID : PIXEL_HALF);
+			ceilingSprite->SetColour(x, y, edge ? FG_GREY : FG_DARK_GREY);
+		}
+	}
+
 	depthBuffer = new float[screenWidth];
+
+	// How far away the floor or ceiling seen through the centre of each row is, straight ahead - the inverse of how walls are sized
+	rowDistances = new float[screenHeight];
+	for (int y = 0; y < screenHeight; ++y)
+		rowDistances[y] = (float)screenHeight / fabsf(((float)y + 0.5f) - ((float)screenHeight / 2.0f));
 }
\ No newline at end of file
@@ -1,6 +1,5 @@
 #pragma once
 #include <algorithm>
-#include <list>
 #include <string>
 #include <vector>
 
@@ -19,6 +18,19 @@ struct Object
 
 };
 
+/**
+ * Billboard
+ * An object that survived culling, placed on the screen ready to be drawn.
+ */
+struct Billboard
+{
+	float depth;
+	float centre;
+	float width;
+	float height;
+	const Sprite* sprite;
+};
+
 /**
  * FirstPerson
  * The app that controls the logic and display of the first person game.
@@ -33,6 +45,8 @@ private:
 	Sprite* wallSprite;
 	Sprite* lampSprite;
 	Sprite* fireBallSprite;
+	Sprite* floorSprite;
+	Sprite* ceilingSprite;
 
 	// Gameplay
 	const float fov = PI / 4.0f;
@@ -45,15 +59,24 @@ private:
 	FVector2 moveVelocity;
 	float playerA;
 
+	// Rendering
+	bool floorCasting;
+	FVector2 leftRay;
+	FVector2 rayStep;
+
 	// World Objects
-	std::list<Object> objects;
+	std::vector<Object> objects;
 
 	float* depthBuffer;
+	float* rowDistances;
 
 	// Game Logic Functions
 	void GameLogic(void) override;
 	void Draw(void) override;
 	void Reset(void);
+	void DrawObjects(CharInfo* cells, const int& columns, const int& rows);
+	void DrawColumns(CharInfo* cells, const int& first, const int& last, const int& rows);
+	bool CastRay(const FVector2& eye, float& distance, float& sampleX) const;
 
 	// Misc Functions
 	void GenerateAssets(void) override;
@@ -0,0 +1,108 @@
+#include <cstdint>
+
+#include "FrameArena.h"
+
+/**
+ * Constructor
+ * @param capacity The size in bytes of the block to start with.
+ */
+Engine::FrameArena::FrameArena(const size_t& capacity) : capacity(capacity), offset(0), overflowSize(0), highWater(0), overflow(nullptr)
+{
+	buffer = new char[capacity];
+}
+
+/**
+ * Destructor
+ */
+Engine::FrameArena::~FrameArena()
+{
+	FreeOverflow();
+
+	if (buffer != nullptr)
+		delete[] buffer;
+}
+
+/**
+ * Allocate()
+ * Takes memory from the arena. It stays valid until the next Reset().
+ * @param size The number of bytes needed.
+ * @param alignment The alignment needed, must be a power of two.
+ * @return Pointer to the memory.
+ */
+void* Engine::FrameArena::Allocate(const size_t& size, const size_t& alignment)
+{
+	uintptr_t base = reinterpret_cast<uintptr_t>(buffer);
+	size_t start = (size_t)(((base + offset + alignment - 1) & ~(uintptr_t)(alignment - 1)) - base);
+
+	if (start + size <= capacity)
+	{
+		offset = start + size;
+		return buffer + start;
+	}
+
+	// Out of room - hand out a block of its own and remember how much more was needed this tick
+	char* block = new char[sizeof(Overflow) + alignment + size];
+	Overflow* header = reinterpret_cast<Overflow*>(block);
+	header->next = overflow;
+	overflow = header;
+	overflowSize += size + alignment;
+
+	uintptr_t data = reinterpret_cast<uintptr_t>(block + sizeof(Overflow));
+	return reinterpret_cast<void*>((data + alignment - 1) & ~(uintptr_t)(alignment - 1));
+}
+
+/**
+ * Reset()
+ * Empties the arena, making everything allocated since the last reset invalid.
+ * If the last tick overflowed, the block is regrown to fit it.
+ */
+void Engine::FrameArena::Reset()
+{
+	size_t used = offset + overflowSize;
+	if (used > highWater)
+		highWater = used;
+
+	if (overflow != nullptr)
+	{
+		FreeOverflow();
+
+		delete[] buffer;
+		capacity = highWater + (highWater / 2);
+		buffer = new char[capacity];
+	}
+
+	offset = 0;
+	overflowSize = 0;
+}
+
+/**
+ * FreeOverflow()
+ * Deletes all the overflow blocks.
+ */
+void Engine::FrameArena::FreeOverflow()
+{
+	while (overflow != nullptr)
+	{
+		Overflow* next = overflow->next;
+		delete[] reinterpret_cast<char*>(overflow);
+		overflow = next;
+	}
+}
+
+/**
+ * Used()
+ * @return The number of bytes allocated since the last reset.
+ */
+size_t Engine::FrameArena::Used() const { return offset + overflowSize; }
+
+/**
+ * Capacity()
+ * @return The size in bytes of the main block.
+ */
+size_t Engine::FrameArena::Capacity() const { return capacity; }
+
+/**
+ * HighWater()
+ * @return The most bytes used in any one tick so far.
+ */
+size_t Engine::FrameArena::HighWater() const { return highWater; }
\ No newline at end of file
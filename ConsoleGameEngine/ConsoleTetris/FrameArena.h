@@ -0,0 +1,73 @@
+#pragma once
+#include <cstddef>
+
+namespace Engine
+{
+	/**
+	 * FrameArena
+	 * A linear allocator for data that only lives for one simulation tick.
+	 * Allocating bumps an offset through one block of memory and freeing does nothing;
+	 * the whole arena is emptied at once when Reset() is called at the start of each tick.
+	 * If a tick needs more than the block holds, the extra comes from overflow blocks
+	 * and the block is grown to fit on the next reset, so after the first few ticks no heap allocations are made.
+	 */
+	class FrameArena
+	{
+	private:
+		/**
+		 * Overflow
+		 * Header of a block allocated when the main block runs out, linked so they can be freed on reset.
+		 */
+		struct Overflow
+		{
+			Overflow* next;
+		};
+
+		char* buffer;
+		size_t capacity;
+		size_t offset;
+		size_t overflowSize;
+		size_t highWater;
+		Overflow* overflow;
+
+		void FreeOverflow(void);
+
+	public:
+		FrameArena(const size_t& capacity = 1024 * 1024);
+		~FrameArena(void);
+
+		void* Allocate(const size_t& size, const size_t& alignment = alignof(std::max_align_t));
+		void Reset(void);
+
+		size_t Used(void) const;
+		size_t Capacity(void) const;
+		size_t HighWater(void) const;
+
+		FrameArena(FrameArena const&) = delete;
+		void operator=(FrameArena const&) = delete;
+	};
+
+	/**
+	 * ArenaAllocator
+	 * Lets standard containers take their memory from a FrameArena, e.g.
+	 *		std::vector<Triangle, ArenaAllocator<Triangle>> triangles(ArenaAllocator<Triangle>(engine->Arena()));
+	 * The container must not outlive the tick it was made in, as its memory is reused after the arena is reset.
+	 */
+	template <typename T>
+	class ArenaAllocator
+	{
+	public:
+		typedef T value_type;
+
+		FrameArena* arena;
+
+		ArenaAllocator(FrameArena& arena) : arena(&arena) { }
+		template <typename U> ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) { }
+
+		T* allocate(size_t count) { return static_cast<T*>(arena->Allocate(count * sizeof(T), alignof(T))); }
+		void deallocate(T*, size_t) { }
+
+		template <typename U> bool operator==(const ArenaAllocator<U>& other) const { return arena == other.arena; }
+		template <typename U> bool operator!=(const ArenaAllocator<U>& other) const { return arena != other.arena; }
+	};
+}
\ No newline at end of file
@@ -8,6 +8,8 @@ Frogger::Frogger(GameEngine* engine, int appID, int width, int height, int fontW
 
 Frogger::~Frogger(void)
 {
+	engine->DestroyGameObject(player);
+
 	if (bus != nullptr)
 		delete bus;
 	if (car != nullptr)
@@ -38,8 +40,8 @@ Frogger::~Frogger(void)
  */
 int Frogger::Update()
 {
-	if (!player->isActive)
-		player->isActive = true;
+	if (!engine->GameObjects().IsActive(player))
+		engine->GameObjects().SetActive(player, true);
 
 	GameLogic();
 	Draw();
@@ -48,7 +50,7 @@ int Frogger::Update()
 		Reset();
 	if (InputHandler::Instance().IsKeyPressed(VK_ESCAPE))
 	{
-		player->isActive = false;
+		engine->GameObjects().SetActive(player, false);
 		Reset();
 		return 0;
 	}
@@ -58,41 +60,46 @@ int Frogger::Update()
 
 void Frogger::GameLogic(void)
 {
+	FVector2& playerPosition = engine->GameObjects().WorldPosition(player);
+
 	// Player Input
 	if (InputHandler::Instance().IsKeyPressed(VK_LEFT))
-		--player->worldPosition.x;
+		--playerPosition.x;
 	if (InputHandler::Instance().IsKeyPressed(VK_RIGHT))
-		++player->worldPosition.x;
+		++playerPosition.x;
 	if (InputHandler::Instance().IsKeyPressed(VK_UP))
-		--player->worldPosition.y;
+		--playerPosition.y;
 	if (InputHandler::Instance().IsKeyPressed(VK_DOWN))
-		++player->worldPosition.y;
+		++playerPosition.y;
 
 	// Move Player on Log
-	if (player->worldPosition.y <= 3)
-		player->worldPosition.x -= lanes[(int)player->worldPosition.y].first * Time::Instance().DeltaTime();
+	if (playerPosition.y <= 3)
+		playerPosition.x -= lanes[(int)playerPosition.y].first * Time::Instance().DeltaTime();
 
 	// Edge Detection
-	if (player->worldPosition.x < 0)
-		player->worldPosition.x = 0;
-	if (player->worldPosition.x >= (screenWidth / cellSize))
-		player->worldPosition.x = (screenWidth / cellSize) - 1;
-	if (player->worldPosition.y < 0)
-		player->worldPosition.y = 0;
-	if (player->worldPosition.y >= (screenHeight / cellSize))
-		player->worldPosition.y = (screenHeight / cellSize) - 1;
+	if (playerPosition.x < 0)
+		playerPosition.x = 0;
+	if (playerPosition.x >= (screenWidth / cellSize))
+		playerPosition.x = (screenWidth / cellSize) - 1;
+	if (playerPosition.y < 0)
+		playerPosition.y = 0;
+	if (playerPosition.y >= (screenHeight / cellSize))
+		playerPosition.y = (screenHeight / cellSize) - 1;
 
 	// Check Danger Buffer For Collision
-	bool topLeft =     dangerBuffer[((int)((player->worldPosition.y * cellSize) + 1)       * screenWidth) + (int)((player->worldPosition.x       * cellSize) + 1)];
-	bool topRight =    dangerBuffer[((int)((player->worldPosition.y * cellSize) + 1)       * screenWidth) + (int)(((player->worldPosition.x + 1) * cellSize) - 1)];
-	bool bottomLeft =  dangerBuffer[((int)(((player->worldPosition.y + 1) * cellSize) - 1) * screenWidth) + (int)((player->worldPosition.x       * cellSize) + 1)];
-	bool bottomRight = dangerBuffer[((int)(((player->worldPosition.y + 1) * cellSize) - 1) * screenWidth) + (int)(((player->worldPosition.x + 1) * cellSize) - 1)];
+	bool topLeft =     dangerBuffer[((int)((playerPosition.y * cellSize) + 1)       * screenWidth) + (int)((playerPosition.x       * cellSize) + 1)];
+	bool topRight =    dangerBuffer[((int)((playerPosition.y * cellSize) + 1)       * screenWidth) + (int)(((playerPosition.x + 1) * cellSize) - 1)];
+	bool bottomLeft =  dangerBuffer[((int)(((playerPosition.y + 1) * cellSize) - 1) * screenWidth) + (int)((playerPosition.x       * cellSize) + 1)];
+	bool bottomRight = dangerBuffer[((int)(((playerPosition.y + 1) * cellSize) - 1) * screenWidth) + (int)(((playerPosition.x + 1) * cellSize) - 1)];
 
 	// Dead - Reset player
 	if (topLeft || topRight || bottomLeft || bottomRight)
-		player->worldPosition = FVector2(8.0f, 9.0f);
+	{
+		playerPosition = FVector2(8.0f, 9.0f);
+		engine->GameObjects().PreviousScreenPosition(player) = playerPosition * cellSize; // Jump straight back to the start rather than sliding there
+	}
 
-	player->screenPosition = player->worldPosition * cellSize;
+	engine->GameObjects().ScreenPosition(player) = playerPosition * cellSize;
 }
 
 void Frogger::Draw(void)
@@ -101,7 +108,7 @@ void Frogger::Draw(void)
 
 	// Draw Lanes
 	int x = -1, y = 0;
-	for (auto lane : lanes)
+	for (const auto& lane : lanes)
 	{
 		// Lane offset
 		int startPos = (int)(Time::Instance().TimeSinceStart() * lane.first) % laneLength;
@@ -194,6 +201,7 @@ void Frogger::GenerateAssets(void)
 	memset(dangerBuffer, 0, sizeof(bool) * screenWidth * screenHeight);
 
 	player = engine->CreateGameObject(8.0f, 9.0f, frog);
-	player->screenPosition = player->worldPosition * cellSize;
-	player->isActive = false;
+	engine->GameObjects().ScreenPosition(player) = engine->GameObjects().WorldPosition(player) * cellSize;
+	engine->GameObjects().PreviousScreenPosition(player) = engine->GameObjects().ScreenPosition(player);
+	engine->GameObjects().SetActive(player, false);
 }
\ No newline at end of file
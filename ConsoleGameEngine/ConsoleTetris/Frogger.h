@@ -27,7 +27,7 @@ private:
 	bool* dangerBuffer;
 
 	// Player
-	GameObject* player;
+	GameObjectHandle player;
 
 	// Game Logic Functions
 	void GameLogic(void);
@@ -0,0 +1,83 @@
+#pragma once
+#include <math.h>
+
+#include "FVector3.h"
+#include "Matrix4x4.h"
+
+namespace Engine { namespace Graphics {
+	/**
+	 * Frustum
+	 * The six planes bounding what a camera can see, in world space, used to throw away whole objects before any of
+	 * their vertices are transformed. Like the math types it is a plain value type defined entirely here.
+	 */
+	class Frustum
+	{
+	public:
+		/**
+		 * Containment
+		 * Where a bounding volume is relative to the frustum.
+		 */
+		enum class Containment
+		{
+			Outside,		// Can't be seen at all
+			Intersecting,	// Partly visible, so its triangles may need clipping
+			Inside			// Wholly visible, so none of its triangles need clipping
+		};
+
+		// Each plane as (a, b, c, d) with a unit normal pointing into the frustum, so ax + by + cz + d is the signed distance
+		float planes[6][4];
+
+		/**
+		 * FromMatrix()
+		 * Pulls the planes out of a view-projection matrix. A point p is inside when -w <= x <= w, -w <= y <= w and 0 <= z <= w
+		 * for (x, y, z, w) = p * viewProjection, and each of those is a plane through world space.
+		 * @param viewProjection The camera's view matrix multiplied by its projection matrix.
+		 * @return The camera's frustum.
+		 */
+		static Frustum FromMatrix(const Physics::Matrix4x4& viewProjection)
+		{
+			const float (&m)[4][4] = viewProjection.matrix;
+			Frustum frustum;
+
+			for (int row = 0; row < 4; ++row)
+			{
+				frustum.planes[0][row] = m[row][3] + m[row][0];	// Left
+				frustum.planes[1][row] = m[row][3] - m[row][0];	// Right
+				frustum.planes[2][row] = m[row][3] + m[row][1];	// Bottom
+				frustum.planes[3][row] = m[row][3] - m[row][1];	// Top
+				frustum.planes[4][row] = m[row][2];				// Near
+				frustum.planes[5][row] = m[row][3] - m[row][2];	// Far
+			}
+
+			for (float (&plane)[4] : frustum.planes)
+			{
+				float length = sqrtf((plane[0] * plane[0]) + (plane[1] * plane[1]) + (plane[2] * plane[2]));
+				if (length != 0.0f)
+					for (float& value : plane)
+						value /= length;
+			}
+
+			return frustum;
+		}
+
+		/**
+		 * ClassifySphere()
+		 * @param centre The centre of the sphere in world space.
+		 * @param radius The radius of the sphere.
+		 * @return Whether the sphere is outside, partly inside or wholly inside the frustum.
+		 */
+		Containment ClassifySphere(const Physics::FVector3& centre, const float& radius) const
+		{
+			Containment containment = Containment::Inside;
+			for (const float (&plane)[4] : planes)
+			{
+				float distance = (plane[0] * centre.x) + (plane[1] * centre.y) + (plane[2] * centre.z) + plane[3];
+				if (distance < -radius)
+					return Containment::Outside;
+				if (distance < radius)
+					containment = Containment::Intersecting;
+			}
+			return containment;
+		}
+	};
+} }
\ No newline at end of file
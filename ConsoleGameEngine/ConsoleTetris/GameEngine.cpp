@@ -1,5 +1,18 @@
 #include "GameEngine.h"
 
+// Set on readySlot while the frame in that slot hasn't been taken by the presenter yet
+static const int FRESH_FRAME = 0x4;
+
+// Width and height in cells of the screen tiles triangles are binned into, each drawn by one thread
+static const int RASTER_TILE_SIZE = 16;
+
+// Columns between the cells where texture coordinates are divided by w, with the rest stepped evenly between them. Must be a power of two
+static const int TEXTURE_SPAN = 8;
+static const float TEXTURE_SPAN_RECIPROCALS[TEXTURE_SPAN + 1] = { 0.0f, 1.0f, 1.0f / 2.0f, 1.0f / 3.0f, 1.0f / 4.0f, 1.0f / 5.0f, 1.0f / 6.0f, 1.0f / 7.0f, 1.0f / 8.0f };
+
+// One whole texture in the 16.16 fixed point texture coordinates are stepped in
+static const float TEXTURE_FIXED_ONE = 65536.0f;
+
 /*
  * Constructor
  * @param name The name that will be displayed on the top bar.
@@ -10,11 +23,37 @@
  */
 Engine::GameEngine::GameEngine(std::wstring name, int width, int height, int fontWidth, int fontHeight) : appName(name), screenWidth(width), screenHeight(height)
 {
-	screenBuffer = new CHAR_INFO[screenWidth * screenHeight];
-	memset(screenBuffer, 0, sizeof(CHAR_INFO) * screenWidth * screenHeight);
-	RenderEngine::Instance().SetupWindow(width, height, fontWidth, fontHeight);
+	screenBuffer = NULL;
+	depthBuffer = NULL;
+	previousBuffer = NULL;
+	dirtySpans = NULL;
+	windowVersion = 0;
+	presentWindowVersion = -1;
+	changedCells = 0;
+	renderTime = 0.0f;
+	allocationCount = 0;
+	frameAllocations = 0;
+
+	for (FrameSlot& slot : frameSlots)
+	{
+		slot.cells = NULL;
+		slot.capacity = 0;
+		slot.windowVersion = -1;
+	}
+	readySlot = 0;
+	simulationSlot = 1;
+	presentSlot = 2;
+	presenting = false;
+
+	ResizeScreen(width, height, fontWidth, fontHeight);
 	Time::Start();
 	close = false;
+	tickRate = 60.0f;
+	renderRateCap = 0.0f;
+	ditherShading = true;
+	headless = false;
+	frameLimit = 0;
+	frameCount = 0;
 }
 
 /*
@@ -24,12 +63,16 @@ Engine::GameEngine::~GameEngine()
 {
 	if (screenBuffer != NULL)
 		delete[] screenBuffer;
+	if (depthBuffer != NULL)
+		delete[] depthBuffer;
+	if (previousBuffer != NULL)
+		delete[] previousBuffer;
+	if (dirtySpans != NULL)
+		delete[] dirtySpans;
 
-	while (!objectPool.empty())
-	{
-		delete objectPool.back();
-		objectPool.pop_back();
-	}
+	for (FrameSlot& slot : frameSlots)
+		if (slot.cells != NULL)
+			delete[] slot.cells;
 }
 
 // ENGINE FUNCTIONS ##########################################################################################################################################
@@ -37,63 +80,527 @@ Engine::GameEngine::~GameEngine()
 /*
  * Start()
  * Used to set the game engine running.
+ * The game is simulated on one thread while finished frames are drawn by a presenter thread,
+ * so the next frame is being built while the last one is still being written out.
+ * Headless runs present each frame on the simulation thread so every frame reaches the backend in order.
  */
 void Engine::GameEngine::Start()
 {
+	presenting = true;
+
+	std::thread presentThread;
+	if (!headless)
+		presentThread = std::thread(&Engine::GameEngine::PresentLoop, this);
+
 	std::thread mainThread = std::thread(&Engine::GameEngine::ThreadUpdate, this);
 	mainThread.join();
+
+	{
+		std::lock_guard<std::mutex> lock(presentMutex);
+		presenting = false;
+	}
+	presentSignal.notify_one();
+
+	if (presentThread.joinable())
+		presentThread.join();
+}
+
+/*
+ * RunHeadless()
+ * Runs the game for a set number of frames without reading input, with time advancing by a fixed step each frame.
+ * Combined with a HeadlessRenderBackend this runs the game as fast as it can simulate and raster,
+ * and gives the same frames on every run.
+ * @param frames The number of frames to run before closing.
+ * @param fixedStep The length of time each frame advances by.
+ */
+void Engine::GameEngine::RunHeadless(const int& frames, const float& fixedStep)
+{
+	headless = true;
+	frameLimit = frames;
+	Time::Instance().SetFixedStep(fixedStep);
+
+	Start();
+
+	Time::Instance().SetFixedStep(0.0f);
+	headless = false;
 }
 
+/*
+ * TickRate()
+ * @return The number of simulation ticks run per second, or 0 if the game ticks once per rendered frame.
+ */
+float Engine::GameEngine::TickRate() const { return tickRate; }
+
+/*
+ * SetTickRate()
+ * Sets how many times per second the game logic runs. Takes effect the next time the game is started.
+ * @param ticksPerSecond The simulation rate, or 0 to tick once per frame with a variable time step.
+ */
+void Engine::GameEngine::SetTickRate(const float& ticksPerSecond) { tickRate = ticksPerSecond; }
+
+/*
+ * RenderRateCap()
+ * @return The most frames rendered per second, or 0 if a frame is rendered after every loop that ran a tick.
+ */
+float Engine::GameEngine::RenderRateCap() const { return renderRateCap; }
+
+/*
+ * SetRenderRateCap()
+ * Limits how often frames are rendered, independent of the tick rate.
+ * @param framesPerSecond The most frames to render per second, or 0 for no limit.
+ */
+void Engine::GameEngine::SetRenderRateCap(const float& framesPerSecond) { renderRateCap = framesPerSecond; }
+
 /*
  * ThreadUpdate()
  * Initializes the game and sets the main game loop running.
+ * The game is simulated in fixed ticks of 1 / tickRate seconds, with as many ticks run each loop as the time passed calls for,
+ * and a frame is rendered after any loop that ran a tick (no more often than the render rate cap if one is set).
+ * The thread sleeps between ticks rather than spinning. In headless mode every loop is one tick and one frame.
  */
 void Engine::GameEngine::ThreadUpdate()
 {
 	// Generate Assets
 	CreateGame();
 
+	// Longest stretch of real time simulated in one loop, so a stall doesn't leave the game trying to catch up forever
+	const float maxFrameTime = 0.25f;
+
+	if (!headless)
+		Time::Instance().SetFixedStep(tickRate > 0.0f ? 1.0f / tickRate : 0.0f);
+
+	std::chrono::steady_clock::time_point previousTime = std::chrono::steady_clock::now();
+	std::chrono::steady_clock::time_point lastRenderTime = previousTime;
+	float accumulator = 0.0f;
+
 	// Main Game Loop
 	while (!close)
 	{
-		InputHandler::Instance().UpdateKeyState(); // Inputhandler is initialized here - on first loop
-		Time::Instance().Update();
+		if (headless)
+		{
+			Tick();
+			Time::Instance().SetInterpolation(1.0f);
+			Render(Time::Instance().FixedStep());
+			continue;
+		}
 
-		beforeTime = std::chrono::system_clock::now();
-		RunGame();
-		afterTime = std::chrono::system_clock::now();
-		runGameTime = (afterTime - beforeTime).count();
+		std::chrono::steady_clock::time_point currentTime = std::chrono::steady_clock::now();
+		float frameTime = std::chrono::duration<float>(currentTime - previousTime).count();
+		previousTime = currentTime;
 
-		RenderObjects();
+		// Variable step - one tick per frame lasting as long as the last frame took
+		if (tickRate <= 0.0f)
+		{
+			Tick();
+			Time::Instance().SetInterpolation(1.0f);
+			Render(frameTime);
+			continue;
+		}
+
+		const float step = 1.0f / tickRate;
+		accumulator += (frameTime > maxFrameTime) ? maxFrameTime : frameTime;
+
+		int ticks = 0;
+		while (accumulator >= step && !close)
+		{
+			Tick();
+			accumulator -= step;
+			++ticks;
+		}
 
-		beforeTime = std::chrono::system_clock::now();
-		RenderEngine::Instance().Draw(appName.c_str(), screenBuffer, runGameTime, renderTime);
-		afterTime = std::chrono::system_clock::now();
-		renderTime = (afterTime - beforeTime).count();
+		float sinceLastRender = std::chrono::duration<float>(currentTime - lastRenderTime).count();
+		if (ticks > 0 && !close && (renderRateCap <= 0.0f || sinceLastRender >= 1.0f / renderRateCap))
+		{
+			Time::Instance().SetInterpolation(accumulator / step);
+			Render(sinceLastRender);
+			lastRenderTime = currentTime;
+		}
+
+		WaitUntil(currentTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(step - accumulator)));
 	}
+
+	if (!headless)
+		Time::Instance().SetFixedStep(0.0f);
 }
 
-// GAMEOBJECT FUNCTIONS ######################################################################################################################################
+/*
+ * Tick()
+ * Advances the game by one simulation step: reads input, moves time forward and runs the game logic.
+ */
+void Engine::GameEngine::Tick()
+{
+	frameArena.Reset();
+
+	if (!headless)
+		InputHandler::Instance().UpdateKeyState(); // Inputhandler is initialized here - on first tick
 
-Engine::GameObject* Engine::GameEngine::CreateGameObject(float x, float y, Sprite* sprite)
+	objectPool.StorePreviousScreenPositions();
+
+	Time::Instance().Update();
+
+	beforeTime = std::chrono::system_clock::now();
+	RunGame();
+	afterTime = std::chrono::system_clock::now();
+	runGameTime += (afterTime - beforeTime).count();
+}
+
+/*
+ * Render()
+ * Draws the GameObjects over the screen buffer and hands a copy of the finished frame to the presenter.
+ * Frames are passed through three slots: the simulation fills one, the presenter draws from another,
+ * and the third holds the newest finished frame. Handing over is a single atomic swap of slot indices,
+ * so neither thread ever waits on the other. If the presenter falls behind, older frames are replaced by newer ones.
+ * @param frameTime The time since the last frame was rendered, used for the frame rate shown.
+ */
+void Engine::GameEngine::Render(const float& frameTime)
 {
-	GameObject* newObject = new GameObject(x, y, sprite);
-	objectPool.push_back(newObject);
-	return newObject;
+	RenderObjects();
+
+	FrameSlot& slot = frameSlots[simulationSlot];
+	int size = screenWidth * screenHeight;
+	if (slot.capacity < size)
+	{
+		if (slot.cells != NULL)
+			delete[] slot.cells;
+		slot.cells = new CharInfo[size];
+		slot.capacity = size;
+	}
+
+	memcpy(slot.cells, screenBuffer, sizeof(CharInfo) * size);
+	slot.width = screenWidth;
+	slot.height = screenHeight;
+	slot.fontWidth = fontWidth;
+	slot.fontHeight = fontHeight;
+	slot.windowVersion = windowVersion;
+	slot.title = appName;
+	// Heap allocations made by the simulation thread since the last frame - should be 0 once a game is running
+	unsigned long long allocations = AllocationCounter::ThreadAllocations();
+	frameAllocations = (int)(allocations - allocationCount);
+	allocationCount = allocations;
+
+	slot.stats = { (frameTime > 0.0f) ? 1.0f / frameTime : 0.0f, runGameTime, renderTime, 0, frameAllocations };
+	runGameTime = 0.0f;
+
+	// Publish the frame and take back whichever slot was waiting - it is either stale or already presented
+	simulationSlot = readySlot.exchange(simulationSlot | FRESH_FRAME) & ~FRESH_FRAME;
+
+	if (headless)
+	{
+		PresentFrame();
+	}
+	else
+	{
+		// Take the lock before signalling so the presenter can't miss the wake up between checking and waiting
+		{
+			std::lock_guard<std::mutex> lock(presentMutex);
+		}
+		presentSignal.notify_one();
+	}
+
+	++frameCount;
+	if (frameLimit > 0 && frameCount >= frameLimit)
+		close = true;
 }
 
-Engine::GameObject* Engine::GameEngine::CreateGameObject(FVector2 position,  Sprite* sprite)
+/*
+ * WaitUntil()
+ * Sleeps the thread until the given time. Sleeps can overrun by a scheduler tick,
+ * so the last couple of milliseconds are spent yielding instead.
+ * @param time The time to wait until.
+ */
+void Engine::GameEngine::WaitUntil(const std::chrono::steady_clock::time_point& time)
 {
-	GameObject* newObject = new GameObject(position, sprite);
-	objectPool.push_back(newObject);
-	return newObject;
+	const std::chrono::milliseconds margin(2);
+
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	while (now < time)
+	{
+		if (time - now > margin)
+			std::this_thread::sleep_for(time - now - margin);
+		else
+			std::this_thread::yield();
+		now = std::chrono::steady_clock::now();
+	}
+}
+
+// PRESENTER FUNCTIONS #######################################################################################################################################
+
+/*
+ * PresentLoop()
+ * Runs on the presenter thread, drawing each new frame as it is handed over until the game stops.
+ */
+void Engine::GameEngine::PresentLoop()
+{
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(presentMutex);
+			presentSignal.wait(lock, [this] { return !presenting || (readySlot.load() & FRESH_FRAME) != 0; });
+
+			if (!presenting)
+				break;
+		}
+
+		PresentFrame();
+	}
+}
+
+/*
+ * PresentFrame()
+ * Takes the newest finished frame, if there is one, and sends the parts that changed to the render backend.
+ * Sets up the window first if the frame was made after the screen was resized.
+ * @return True if a frame was drawn.
+ */
+bool Engine::GameEngine::PresentFrame()
+{
+	if ((readySlot.load() & FRESH_FRAME) == 0)
+		return false;
+
+	presentSlot = readySlot.exchange(presentSlot) & ~FRESH_FRAME;
+	FrameSlot& frame = frameSlots[presentSlot];
+
+	if (frame.windowVersion != presentWindowVersion)
+	{
+		if (previousBuffer != NULL)
+			delete[] previousBuffer;
+		if (dirtySpans != NULL)
+			delete[] dirtySpans;
+
+		previousBuffer = new CharInfo[frame.width * frame.height];
+		dirtySpans = new DirtySpan[frame.height];
+		memset(previousBuffer, 0, sizeof(CharInfo) * frame.width * frame.height);
+
+		RenderEngine::Instance().SetupWindow(frame.width, frame.height, frame.fontWidth, frame.fontHeight);
+		presentWindowVersion = frame.windowVersion;
+		forceFullRedraw = true;
+	}
+
+	std::chrono::time_point<std::chrono::system_clock> beforeDraw = std::chrono::system_clock::now();
+	int spanCount = FindDirtySpans(frame);
+	frame.stats.changedCells = changedCells;
+	RenderEngine::Instance().Draw(frame.title.c_str(), frame.cells, dirtySpans, spanCount, frame.stats);
+	std::chrono::time_point<std::chrono::system_clock> afterDraw = std::chrono::system_clock::now();
+	renderTime = (float)(afterDraw - beforeDraw).count();
+
+	return true;
 }
 
+/*
+ * ResizeScreen()
+ * Reallocates the screen buffer for a new screen size.
+ * The window is set up to match, and drawn in full, once the next frame is presented.
+ * @param width Character width of the screen.
+ * @param height Character height of the screen.
+ * @param fontWidth Pixel width of the font.
+ * @param fontHeight Pixel height of the font.
+ */
+void Engine::GameEngine::ResizeScreen(const int& width, const int& height, const int& fontWidth, const int& fontHeight)
+{
+	screenWidth = width;
+	screenHeight = height;
+
+	this->fontWidth = fontWidth;
+	this->fontHeight = fontHeight;
+
+	if (screenBuffer != NULL)
+		delete[] screenBuffer;
+
+	screenBuffer = new CharInfo[screenWidth * screenHeight];
+	memset(screenBuffer, 0, sizeof(CharInfo) * screenWidth * screenHeight);
+
+	if (depthBuffer != NULL)
+		delete[] depthBuffer;
+
+	depthBuffer = new float[screenWidth * screenHeight];
+	ClearDepth();
+
+	// The presenter sets up the window when the first frame made at the new size reaches it
+	++windowVersion;
+}
+
+// DIRTY RECTANGLE FUNCTIONS #################################################################################################################################
+
+/*
+ * FindDirtySpans()
+ * Compares a frame against the last frame drawn and stores the changed span of each row in dirtySpans.
+ * The previous frame is brought up to date as it goes, so each span is only reported once.
+ * @param frame The frame about to be drawn.
+ * @return The number of dirty spans found.
+ */
+int Engine::GameEngine::FindDirtySpans(const FrameSlot& frame)
+{
+	auto same = [](const CharInfo& a, const CharInfo& b) { return a.Char.UnicodeChar == b.Char.UnicodeChar && a.Attributes == b.Attributes; };
+
+	const int width = frame.width;
+	const int height = frame.height;
+	const bool fullRedraw = forceFullRedraw.exchange(false);
+
+	int spanCount = 0;
+	changedCells = 0;
+
+	for (int y = 0; y < height; ++y)
+	{
+		const CharInfo* current = &frame.cells[y * width];
+		CharInfo* previous = &previousBuffer[y * width];
+
+		if (fullRedraw)
+		{
+			dirtySpans[spanCount++] = { (short)y, 0, (short)(width - 1) };
+			changedCells += width;
+			memcpy(previous, current, sizeof(CharInfo) * width);
+			continue;
+		}
+
+		// Most rows are untouched between frames so skip them in one go
+		if (memcmp(current, previous, sizeof(CharInfo) * width) == 0)
+			continue;
+
+		int minX = 0;
+		while (minX < width && same(current[minX], previous[minX]))
+			++minX;
+		int maxX = width - 1;
+		while (maxX >= minX && same(current[maxX], previous[maxX]))
+			--maxX;
+
+		for (int x = minX; x <= maxX; ++x)
+			if (!same(current[x], previous[x]))
+				++changedCells;
+
+		if (minX <= maxX)
+		{
+			dirtySpans[spanCount++] = { (short)y, (short)minX, (short)maxX };
+			memcpy(&previous[minX], &current[minX], sizeof(CharInfo) * (maxX - minX + 1));
+		}
+	}
+
+	return spanCount;
+}
+
+/*
+ * ForceFullRedraw()
+ * Makes the next frame draw the whole screen buffer rather than only the parts that have changed.
+ */
+void Engine::GameEngine::ForceFullRedraw() { forceFullRedraw = true; }
+
+/*
+ * ChangedCells()
+ * @return The number of characters that changed in the last frame drawn.
+ */
+int Engine::GameEngine::ChangedCells() const { return changedCells; }
+
+/*
+ * FrameCount()
+ * @return The number of frames run since the game started.
+ */
+int Engine::GameEngine::FrameCount() const { return frameCount; }
+
+/*
+ * FrameAllocations()
+ * @return The number of heap allocations the simulation made while building the last frame.
+ */
+int Engine::GameEngine::FrameAllocations() const { return frameAllocations; }
+
+/*
+ * ScreenWidth()
+ * @return The width of the screen in characters.
+ */
+int Engine::GameEngine::ScreenWidth() const { return screenWidth; }
+
+/*
+ * ScreenHeight()
+ * @return The height of the screen in characters.
+ */
+int Engine::GameEngine::ScreenHeight() const { return screenHeight; }
+
+/*
+ * ScreenBuffer()
+ * Gives direct access to the cells being drawn this tick, row by row, for drawing code that fills a lot of them at once
+ * or from several threads. Nothing is bounds checked, unlike the Draw functions.
+ * @return The first cell of the screen buffer.
+ */
+CharInfo* Engine::GameEngine::ScreenBuffer() { return screenBuffer; }
+
+/*
+ * Arena()
+ * The arena is emptied at the start of every tick, so anything allocated from it must not be kept past the end of RunGame().
+ * @return The arena for memory that is only needed during the current tick.
+ */
+Engine::FrameArena& Engine::GameEngine::Arena() { return frameArena; }
+
+/*
+ * RasterPool()
+ * @return The threads DrawFillTrianglesDepth() splits its tiles across, which apps can also share their own drawing out across.
+ */
+Engine::ThreadPool& Engine::GameEngine::RasterPool() { return rasterPool; }
+
+/*
+ * ShadeDithering()
+ * @return Whether shaded triangles are dithered between brightness steps, rather than rounded down to one.
+ */
+bool Engine::GameEngine::ShadeDithering() const { return ditherShading; }
+
+/*
+ * SetShadeDithering()
+ * @param dither Whether shaded triangles should be dithered between brightness steps, rather than rounded down to one.
+ */
+void Engine::GameEngine::SetShadeDithering(const bool& dither) { ditherShading = dither; }
+
+// GAMEOBJECT FUNCTIONS ######################################################################################################################################
+
+/*
+ * CreateGameObject()
+ * Adds a new active GameObject to the game.
+ * @param x The X position of the GameObject in screenspace.
+ * @param y The Y position of the GameObject in screenspace.
+ * @param sprite The sprite to be displayed.
+ * @return The handle used to access the GameObject through GameObjects().
+ */
+Engine::GameObjectHandle Engine::GameEngine::CreateGameObject(float x, float y, Sprite* sprite) { return objectPool.Create(FVector2(x, y), sprite); }
+
+/*
+ * CreateGameObject()
+ * Adds a new active GameObject to the game.
+ * @param position The position of the GameObject in screenspace.
+ * @param sprite The sprite to be displayed.
+ * @return The handle used to access the GameObject through GameObjects().
+ */
+Engine::GameObjectHandle Engine::GameEngine::CreateGameObject(FVector2 position, Sprite* sprite) { return objectPool.Create(position, sprite); }
+
+/*
+ * DestroyGameObject()
+ * Removes a GameObject from the game.
+ * @param handle The GameObject to remove.
+ * @return True if the GameObject existed and was removed.
+ */
+bool Engine::GameEngine::DestroyGameObject(const GameObjectHandle& handle) { return objectPool.Destroy(handle); }
+
+/*
+ * GameObjects()
+ * @return The pool holding every GameObject in the game.
+ */
+Engine::GameObjectPool& Engine::GameEngine::GameObjects() { return objectPool; }
+
+/*
+ * RenderObjects()
+ * Draws every active GameObject, placed between where it was at the previous tick and where it is now.
+ */
 void Engine::GameEngine::RenderObjects()
 {
-	for (GameObject* object : objectPool)
-		if (object->isActive)
-			DrawSprite((int)object->screenPosition.x, (int)object->screenPosition.y, *(object->GetSprite()));
+	const float alpha = Time::Instance().Interpolation();
+	const unsigned int count = objectPool.ActiveCount();
+	const FVector2* current = objectPool.ScreenPositions();
+	const FVector2* previous = objectPool.PreviousScreenPositions();
+	Sprite* const* sprites = objectPool.Sprites();
+
+	for (unsigned int i = 0; i < count; ++i)
+	{
+		if (sprites[i] == nullptr)
+			continue;
+
+		float x = previous[i].x + (current[i].x - previous[i].x) * alpha;
+		float y = previous[i].y + (current[i].y - previous[i].y) * alpha;
+		DrawSprite((int)x, (int)y, *sprites[i]);
+	}
 }
 
 // DRAWING FUNCTIONS #########################################################################################################################################
@@ -111,6 +618,16 @@ void Engine::GameEngine::ClearScreen()
 	}
 }
 
+/*
+ * ClearDepth()
+ * Resets every cell of the depth buffer to as far away as possible, so the next thing drawn with depth testing always shows.
+ */
+void Engine::GameEngine::ClearDepth()
+{
+	// Every byte 0x7F makes each depth about 3.4e38, further than anything drawn, and lets the whole buffer be set in one memset
+	memset(depthBuffer, 0x7F, sizeof(float) * screenWidth * screenHeight);
+}
+
 /*
  * DrawChar()
  * Will change a character and its colour in the screen buffer at the specified coordinates.
@@ -335,6 +852,104 @@ next:
 	}
 }
 
+/*
+ * DrawFillTriangleDepth()
+ * Fills a triangle, only drawing the cells where it is closer than what has already been drawn there.
+ * See FillTriangleDepth() for which cells are covered.
+ * @param x0 The x coordinate of the first point of the triangle.
+ * @param y0 The y coordinate of the first point of the triangle.
+ * @param z0 The depth of the first point of the triangle.
+ * @param x1 The x coordinate of the second point of the triangle.
+ * @param y1 The y coordinate of the second point of the triangle.
+ * @param z1 The depth of the second point of the triangle.
+ * @param x2 The x coordinate of the third point of the triangle.
+ * @param y2 The y coordinate of the third point of the triangle.
+ * @param z2 The depth of the third point of the triangle.
+ * @param character What the character should be.
+ * @param colour The new colour of the character.
+ */
+void Engine::GameEngine::DrawFillTriangleDepth(float x0, float y0, float z0, float x1, float y1, float z1, float x2, float y2, float z2, const short& character, const short& colour)
+{
+	Triangle triangle(FVector3(x0, y0, z0), FVector3(x1, y1, z1), FVector3(x2, y2, z2));
+	triangle.pixel = character;
+	triangle.colour = colour;
+
+	RasterTriangle setup;
+	if (SetupTriangle(triangle, setup))
+		FillTriangleDepth(setup, setup.minX, setup.minY, setup.maxX, setup.maxY);
+}
+
+/*
+ * DrawFillTrianglesDepth()
+ * Fills a batch of triangles against the depth buffer, split across the raster pool.
+ * The screen is cut into tiles and each triangle is binned into every tile its bounds touch. Each tile is then drawn
+ * by one thread only, which keeps to the cells inside it, so no two threads ever write the same cell and no locks are needed.
+ * Within a tile triangles are drawn in the order given, so the result is the same as drawing them one at a time.
+ * @param triangles The triangles in screen space, with the depth of each point in z.
+ * @param count The number of triangles.
+ */
+void Engine::GameEngine::DrawFillTrianglesDepth(const Triangle* triangles, const size_t& count)
+{
+	RasterTriangle* setups = static_cast<RasterTriangle*>(frameArena.Allocate(sizeof(RasterTriangle) * count, alignof(RasterTriangle)));
+	int setupCount = 0;
+	for (size_t i = 0; i < count; ++i)
+		if (SetupTriangle(triangles[i], setups[setupCount]))
+			++setupCount;
+
+	// Nothing to share the work with - binning would only add to it
+	if (rasterPool.WorkerCount() == 0)
+	{
+		for (int i = 0; i < setupCount; ++i)
+			FillTriangleDepth(setups[i], setups[i].minX, setups[i].minY, setups[i].maxX, setups[i].maxY);
+		return;
+	}
+
+	int tilesX = (screenWidth + RASTER_TILE_SIZE - 1) / RASTER_TILE_SIZE;
+	int tilesY = (screenHeight + RASTER_TILE_SIZE - 1) / RASTER_TILE_SIZE;
+	int tileCount = tilesX * tilesY;
+
+	int* binStarts = static_cast<int*>(frameArena.Allocate(sizeof(int) * (tileCount + 1), alignof(int)));
+	int* binEnds = static_cast<int*>(frameArena.Allocate(sizeof(int) * tileCount, alignof(int)));
+	memset(binEnds, 0, sizeof(int) * tileCount);
+
+	// First pass - count the triangles in each tile
+	for (int i = 0; i < setupCount; ++i)
+		for (int tileY = setups[i].minY / RASTER_TILE_SIZE; tileY <= setups[i].maxY / RASTER_TILE_SIZE; ++tileY)
+			for (int tileX = setups[i].minX / RASTER_TILE_SIZE; tileX <= setups[i].maxX / RASTER_TILE_SIZE; ++tileX)
+				++binEnds[(tileY * tilesX) + tileX];
+
+	// Lay the bins out one after another
+	binStarts[0] = 0;
+	for (int tile = 0; tile < tileCount; ++tile)
+	{
+		binStarts[tile + 1] = binStarts[tile] + binEnds[tile];
+		binEnds[tile] = binStarts[tile];
+	}
+
+	// Second pass - fill the bins, keeping the triangles in order
+	int* bins = static_cast<int*>(frameArena.Allocate(sizeof(int) * (binStarts[tileCount] + 1), alignof(int)));
+	for (int i = 0; i < setupCount; ++i)
+		for (int tileY = setups[i].minY / RASTER_TILE_SIZE; tileY <= setups[i].maxY / RASTER_TILE_SIZE; ++tileY)
+			for (int tileX = setups[i].minX / RASTER_TILE_SIZE; tileX <= setups[i].maxX / RASTER_TILE_SIZE; ++tileX)
+				bins[binEnds[(tileY * tilesX) + tileX]++] = i;
+
+	auto drawTile = [&](int tile)
+	{
+		int minX = (tile % tilesX) * RASTER_TILE_SIZE;
+		int minY = (tile / tilesX) * RASTER_TILE_SIZE;
+		int maxX = (minX + RASTER_TILE_SIZE < screenWidth) ? minX + RASTER_TILE_SIZE - 1 : screenWidth - 1;
+		int maxY = (minY + RASTER_TILE_SIZE < screenHeight) ? minY + RASTER_TILE_SIZE - 1 : screenHeight - 1;
+
+		for (int i = binStarts[tile]; i < binEnds[tile]; ++i)
+		{
+			const RasterTriangle& triangle = setups[bins[i]];
+			FillTriangleDepth(triangle, (minX > triangle.minX) ? minX : triangle.minX, (minY > triangle.minY) ? minY : triangle.minY,
+							  (maxX < triangle.maxX) ? maxX : triangle.maxX, (maxY < triangle.maxY) ? maxY : triangle.maxY);
+		}
+	};
+	rasterPool.ParallelFor(tileCount, drawTile);
+}
+
 /*
  * DrawRect()
  * Draws the outline of a rectangle that will map to the top left and bottom right coordinates given.
@@ -403,11 +1018,23 @@ void Engine::GameEngine::DrawRectFill(const int& minX, const int& minY, const in
  * @param msg The string to be printed on screen.
  * @param colour The new colour of the string.
  */
-void Engine::GameEngine::DrawString(const int& x, const int& y, const std::wstring& msg, const short& colour)
+void Engine::GameEngine::DrawString(const int& x, const int& y, const std::wstring& msg, const short& colour) { DrawString(x, y, msg.c_str(), colour); }
+
+/*
+ * DrawString()
+ * Will print a string on screen starting at the coordinates given.
+ * Takes the text straight from a buffer, so text formatted each frame doesn't need a std::wstring built for it.
+ * @param x The x coordinate of the start of the string.
+ * @param y The y coordinate of the start of the string.
+ * @param msg The null terminated string to be printed on screen.
+ * @param colour The new colour of the string.
+ */
+void Engine::GameEngine::DrawString(const int& x, const int& y, const wchar_t* msg, const short& colour)
 {
 	// TODO: Error check
-	if (x >= 0 && x < (int)(screenWidth - msg.size()) && y >= 0 && y < screenHeight)
-		for (int i = 0; i < (int)msg.size(); i++)
+	int length = (int)wcslen(msg);
+	if (x >= 0 && x < screenWidth - length && y >= 0 && y < screenHeight)
+		for (int i = 0; i < length; i++)
 			DrawChar(x + i, y, msg[i], colour);
 }
 
@@ -420,11 +1047,23 @@ void Engine::GameEngine::DrawString(const int& x, const int& y, const std::wstri
  * @param msg The string to be printed on screen.
  * @param colour The new colour of the string.
  */
-void Engine::GameEngine::DrawStringAlpha(const int& x, const int& y, const std::wstring& msg, const short& colour)
+void Engine::GameEngine::DrawStringAlpha(const int& x, const int& y, const std::wstring& msg, const short& colour) { DrawStringAlpha(x, y, msg.c_str(), colour); }
+
+/*
+ * DrawStringAlpha()
+ * Will print a string on screen starting at the coordinates given.
+ * All spaces will be ignored.
+ * @param x The x coordinate of the start of the string.
+ * @param y The y coordinate of the start of the string.
+ * @param msg The null terminated string to be printed on screen.
+ * @param colour The new colour of the string.
+ */
+void Engine::GameEngine::DrawStringAlpha(const int& x, const int& y, const wchar_t* msg, const short& colour)
 {
 	// TODO: Error check
-	if (x >= 0 && x < (int)(screenWidth - msg.size()) && y >= 0 && y < screenHeight)
-		for (int i = 0; i < (int)msg.size(); i++)
+	int length = (int)wcslen(msg);
+	if (x >= 0 && x < screenWidth - length && y >= 0 && y < screenHeight)
+		for (int i = 0; i < length; i++)
 			if (msg[i] != ' ')
 				DrawChar(x + i, y, msg[i], colour);
 }
@@ -473,87 +1112,301 @@ void Engine::GameEngine::DrawPartialSprite(const int& x, const int& y, const int
  * @param lum The brightness of the colour.
  * @return Character information about the character and colour used to create the desired colour.
  */
-CHAR_INFO Engine::GameEngine::GetGreyScaleColour(const float& lum)
+CharInfo Engine::GameEngine::GetGreyScaleColour(const float& lum)
 {
-	short bgCol, fgCol;
-	short sym;
-	int pixelBw = (int)(13.0f * lum);
-
-	switch (pixelBw)
-	{
-	case 0: bgCol = BG_BLACK; fgCol = FG_DARK_GREY; sym = PIXEL_QUARTER; break;
-
-	case 1: bgCol = BG_BLACK; fgCol = FG_DARK_GREY; sym = PIXEL_QUARTER; break;
-	case 2: bgCol = BG_BLACK; fgCol = FG_DARK_GREY; sym = PIXEL_HALF; break;
-	case 3: bgCol = BG_BLACK; fgCol = FG_DARK_GREY; sym = PIXEL_THREEQUARTER; break;
-	case 4: bgCol = BG_BLACK; fgCol = FG_DARK_GREY; sym = PIXEL_SOLID; break;
-
-	case 5: bgCol = BG_DARK_GREY; fgCol = FG_GREY; sym = PIXEL_QUARTER; break;
-	case 6: bgCol = BG_DARK_GREY; fgCol = FG_GREY; sym = PIXEL_HALF; break;
-	case 7: bgCol = BG_DARK_GREY; fgCol = FG_GREY; sym = PIXEL_THREEQUARTER; break;
-	case 8: bgCol = BG_DARK_GREY; fgCol = FG_GREY; sym = PIXEL_SOLID; break;
-
-	case 9:  bgCol = BG_GREY; fgCol = FG_WHITE; sym = PIXEL_QUARTER; break;
-	case 10: bgCol = BG_GREY; fgCol = FG_WHITE; sym = PIXEL_HALF; break;
-	case 11: bgCol = BG_GREY; fgCol = FG_WHITE; sym = PIXEL_THREEQUARTER; break;
-	case 12: bgCol = BG_GREY; fgCol = FG_WHITE; sym = PIXEL_SOLID; break;
-	default: bgCol = BG_BLACK; fgCol = FG_BLACK; sym = PIXEL_SOLID;
-	}
+	// Anything outside the ramp is black
+	int step = (int)(13.0f * lum);
+	Shade shade = (step >= 0 && step < GREY_SHADE_STEPS) ? SHADE_TABLE.greys[step] : Shade{ PIXEL_SOLID, BG_BLACK | FG_BLACK };
 
-	CHAR_INFO character;
-	character.Char.UnicodeChar = sym;
-	character.Attributes = bgCol | fgCol;
+	CharInfo character;
+	character.Char.UnicodeChar = shade.character;
+	character.Attributes = shade.colour;
 	return character;
 }
 
 /**
- * GetGreyScaleColour()
+ * GetColour()
  * Given a luminosity between 0.0f and 1.0f, will return a colour with that brightness.
  * 0.0f will give a black and 1.0f will give a white.
  * @param baseColour The colour to be used as the base colour
  * @param lum The brightness of the colour.
  * @return Character information about the character and colour used to create the desired colour.
  */
-CHAR_INFO Engine::GameEngine::GetColour(const short& baseColour, const float& lum)
+CharInfo Engine::GameEngine::GetColour(const short& baseColour, const float& lum)
+{
+	// Anything outside the ramp is black
+	int step = (int)(19.0f * lum);
+	Shade shade = (step >= 0 && step < SHADE_STEPS) ? SHADE_TABLE.colours[baseColour & 0x0F][step] : Shade{ PIXEL_SOLID, BG_BLACK | FG_BLACK };
+
+	CharInfo character;
+	character.Char.UnicodeChar = shade.character;
+	character.Attributes = shade.colour;
+	return character;
+}
+
+// RASTERISING FUNCTIONS ######################################################################################################################################
+
+/*
+ * Gradient()
+ * Works out how a value given at each point of a triangle changes down its long edge and along a row.
+ * @param value0 The value at the top point.
+ * @param value1 The value at the middle point.
+ * @param value2 The value at the bottom point.
+ * @param height1 How far below the top point the middle point is.
+ * @param height2 How far below the top point the bottom point is.
+ * @param area Twice the signed area of the triangle.
+ * @param longStep Set to how much the value changes per row down the long edge.
+ * @param stepX Set to how much the value changes per column, anywhere in the triangle.
+ */
+static inline void Gradient(const float& value0, const float& value1, const float& value2, const float& height1, const float& height2, const float& area, float& longStep, float& stepX)
+{
+	longStep = (value2 - value0) / height2;
+	stepX = (((value1 - value0) * height2) - ((value2 - value0) * height1)) / area;
+}
+
+/*
+ * SetupTriangle()
+ * Sorts a triangle's points top to bottom and works out everything about it that stays the same from row to row.
+ * Depth is interpolated linearly across the screen, which is correct for depths that have been through the perspective divide.
+ * The brightness of shaded triangles is interpolated the same way, which is Gouraud shading. Texture coordinates aren't linear
+ * on the screen, but divided by w they are, so those are what is interpolated.
+ * @param triangle The triangle in screen space, with the depth of each point in z.
+ * @param setup Set to the triangle ready to be filled.
+ * @return False if the triangle covers no cells on the screen, so doesn't need filling.
+ */
+bool Engine::GameEngine::SetupTriangle(const Triangle& triangle, RasterTriangle& setup) const
 {
-	short darkColour = baseColour - 8;
+	// Sort vertices top to bottom
+	int order[3] = { 0, 1, 2 };
+	if (triangle.points[order[0]].y > triangle.points[order[1]].y) std::swap(order[0], order[1]);
+	if (triangle.points[order[0]].y > triangle.points[order[2]].y) std::swap(order[0], order[2]);
+	if (triangle.points[order[1]].y > triangle.points[order[2]].y) std::swap(order[1], order[2]);
+
+	const FVector3& p0 = triangle.points[order[0]];
+	const FVector3& p1 = triangle.points[order[1]];
+	const FVector3& p2 = triangle.points[order[2]];
+	float x0 = p0.x, y0 = p0.y, z0 = p0.z;
+	float x1 = p1.x, y1 = p1.y, z1 = p1.z;
+	float x2 = p2.x, y2 = p2.y, z2 = p2.z;
+
+	// Twice the signed area - zero for triangles that are a line or a point, which cover nothing
+	float area = ((x1 - x0) * (y2 - y0)) - ((x2 - x0) * (y1 - y0));
+	if (area == 0.0f)
+		return false;
+
+	// The cells whose centres could be inside the triangle, kept on screen
+	float minX = fmaxf(ceilf(fminf(x0, fminf(x1, x2)) - 0.5f), 0.0f);
+	float maxX = fminf(ceilf(fmaxf(x0, fmaxf(x1, x2)) - 0.5f) - 1.0f, (float)screenWidth - 1.0f);
+	float minY = fmaxf(ceilf(y0 - 0.5f), 0.0f);
+	float maxY = fminf(ceilf(y2 - 0.5f) - 1.0f, (float)screenHeight - 1.0f);
+	if (minX > maxX || minY > maxY)
+		return false;
+
+	setup.x0 = x0;
+	setup.y0 = y0;
+	setup.z0 = z0;
+	setup.x1 = x1;
+	setup.y1 = y1;
 
-	short bgCol, fgCol;
-	short sym;
-	int pixelBw = (int)(19.0f * lum);
+	// How far each edge moves across per row
+	setup.longStepX = (x2 - x0) / (y2 - y0);
+	setup.topStepX = (y1 > y0) ? (x1 - x0) / (y1 - y0) : 0.0f;
+	setup.bottomStepX = (y2 > y1) ? (x2 - x1) / (y2 - y1) : 0.0f;
 
-	switch (pixelBw)
+	// Depth changes by the same amount for every step along a row, anywhere in the triangle
+	Gradient(z0, z1, z2, y1 - y0, y2 - y0, area, setup.longStepZ, setup.depthStepX);
+
+	// Brightness in shade levels, so each cell's level is only a truncation away
+	float l0 = triangle.shades[order[0]] * (float)SHADE_LEVELS;
+	setup.level0 = l0;
+	Gradient(l0, triangle.shades[order[1]] * (float)SHADE_LEVELS, triangle.shades[order[2]] * (float)SHADE_LEVELS, y1 - y0, y2 - y0, area, setup.longStepLevel, setup.levelStepX);
+
+	setup.texture = (triangle.texture != nullptr && triangle.texture->TexelWidth() > 0 && triangle.texture->TexelHeight() > 0) ? triangle.texture : nullptr;
+	if (setup.texture != nullptr)
 	{
-	case 0: bgCol = BG_BLACK; fgCol = BG_BLACK; sym = PIXEL_SOLID; break;
+		const float* q = triangle.inverseW;
+		setup.u0 = triangle.texU[order[0]] * q[order[0]];
+		setup.v0 = triangle.texV[order[0]] * q[order[0]];
+		setup.q0 = q[order[0]];
+		Gradient(setup.u0, triangle.texU[order[1]] * q[order[1]], triangle.texU[order[2]] * q[order[2]], y1 - y0, y2 - y0, area, setup.longStepU, setup.uStepX);
+		Gradient(setup.v0, triangle.texV[order[1]] * q[order[1]], triangle.texV[order[2]] * q[order[2]], y1 - y0, y2 - y0, area, setup.longStepV, setup.vStepX);
+		Gradient(setup.q0, q[order[1]], q[order[2]], y1 - y0, y2 - y0, area, setup.longStepQ, setup.qStepX);
+	}
+
+	setup.minX = (int)minX;
+	setup.minY = (int)minY;
+	setup.maxX = (int)maxX;
+	setup.maxY = (int)maxY;
+	setup.character = triangle.pixel;
+	setup.colour = triangle.colour;
+	setup.shadeColour = triangle.shadeColour & 0x0F;
+	return true;
+}
 
-	case 1: bgCol = BG_BLACK; fgCol = darkColour; sym = PIXEL_QUARTER; break;
-	case 2: bgCol = BG_BLACK; fgCol = darkColour; sym = PIXEL_HALF; break;
+/*
+ * FillTriangleDepth()
+ * Fills the part of a triangle inside a rectangle of the screen one row at a time, only drawing the cells where it is closer
+ * than what has already been drawn there. A cell is covered if its centre is inside the triangle, with centres exactly on
+ * the bottom or right edge left to the next triangle, so triangles sharing an edge never both draw the same cell or leave a gap.
+ * Every cell's coverage, depth and shade is worked out from the triangle alone, so the rectangle never changes what is drawn inside it.
+ * Shaded triangles take each cell's character and colour from the shade table rather than the triangle, and textured ones from their texture.
+ * @param triangle The triangle, set up by SetupTriangle().
+ * @param minX The leftmost column that may be drawn to.
+ * @param minY The top row that may be drawn to.
+ * @param maxX The rightmost column that may be drawn to.
+ * @param maxY The bottom row that may be drawn to.
+ */
+void Engine::GameEngine::FillTriangleDepth(const RasterTriangle& triangle, const int& minX, const int& minY, const int& maxX, const int& maxY)
+{
+	for (int y = minY; y <= maxY; ++y)
+	{
+		float sampleY = (float)y + 0.5f;
 
-	case 3: bgCol = BG_BLACK; fgCol = baseColour; sym = PIXEL_QUARTER; break;
-	case 4: bgCol = BG_BLACK; fgCol = baseColour; sym = PIXEL_HALF; break;
+		// Where the row crosses the long edge from the top point to the bottom one, and the short edge on the other side
+		float longX = triangle.x0 + ((sampleY - triangle.y0) * triangle.longStepX);
+		float longZ = triangle.z0 + ((sampleY - triangle.y0) * triangle.longStepZ);
+		float shortX = (sampleY < triangle.y1) ? triangle.x0 + ((sampleY - triangle.y0) * triangle.topStepX) : triangle.x1 + ((sampleY - triangle.y1) * triangle.bottomStepX);
 
-	case 5: bgCol = BG_BLACK; fgCol = darkColour; sym = PIXEL_THREEQUARTER; break;
-	case 6: bgCol = BG_BLACK; fgCol = darkColour; sym = PIXEL_SOLID; break;
-	case 7: bgCol = BG_DARK_GREY; fgCol = darkColour; sym = PIXEL_SOLID; break;
-	case 8: bgCol = BG_GREY; fgCol = darkColour; sym = PIXEL_SOLID; break;
-	case 9: bgCol = BG_WHITE; fgCol = darkColour; sym = PIXEL_SOLID; break;
+		float left = fminf(longX, shortX);
+		float right = fmaxf(longX, shortX);
 
-	case 10: bgCol = BG_BLACK; fgCol = baseColour; sym = PIXEL_THREEQUARTER; break;
-	case 11: bgCol = BG_BLACK; fgCol = baseColour; sym = PIXEL_SOLID; break;
-	case 12: bgCol = BG_DARK_GREY; fgCol = baseColour; sym = PIXEL_SOLID; break;
-	case 13: bgCol = BG_GREY; fgCol = baseColour; sym = PIXEL_SOLID; break;
-	case 14: bgCol = BG_WHITE; fgCol = baseColour; sym = PIXEL_SOLID; break;
-	case 15: bgCol = BG_WHITE; fgCol = baseColour; sym = PIXEL_THREEQUARTER; break;
-	case 16: bgCol = BG_WHITE; fgCol = baseColour; sym = PIXEL_HALF; break;
-	case 17: bgCol = BG_WHITE; fgCol = baseColour; sym = PIXEL_QUARTER; break;
+		// Columns whose centre lies inside the span, kept inside the rectangle
+		float firstColumn = fmaxf(ceilf(left - 0.5f), (float)minX);
+		float lastColumn = fminf(ceilf(right - 0.5f) - 1.0f, (float)maxX);
+		if (firstColumn > lastColumn)
+			continue;
 
-	case 18: bgCol = BG_WHITE; fgCol = FG_WHITE; sym = PIXEL_QUARTER; break;
+		// Depth at the centre of the cell in column 0 of this row, so each cell's depth doesn't depend on where the span starts
+		float rowZ = longZ + ((0.5f - longX) * triangle.depthStepX);
+		int rowStart = y * screenWidth;
 
-	default: bgCol = BG_BLACK; fgCol = FG_BLACK; sym = PIXEL_SOLID;
+		if (triangle.texture != nullptr)
+		{
+			FillTexturedRow(triangle, y, sampleY, longX, rowZ, (int)ceilf(left - 0.5f), (int)ceilf(right - 0.5f) - 1, (int)firstColumn, (int)lastColumn);
+			continue;
+		}
+
+		if (triangle.shadeColour == 0)
+		{
+			for (int x = (int)firstColumn; x <= (int)lastColumn; ++x)
+			{
+				float z = rowZ + ((float)x * triangle.depthStepX);
+				if (z < depthBuffer[rowStart + x])
+				{
+					depthBuffer[rowStart + x] = z;
+					screenBuffer[rowStart + x].Char.UnicodeChar = triangle.character;
+					screenBuffer[rowStart + x].Attributes = triangle.colour;
+				}
+			}
+			continue;
+		}
+
+		// Shaded - each cell's brightness is looked up in the shade table, dithered between steps if asked for
+		float longLevel = triangle.level0 + ((sampleY - triangle.y0) * triangle.longStepLevel);
+		float rowLevel = longLevel + ((0.5f - longX) * triangle.levelStepX);
+		const Shade* ramp = SHADE_TABLE.colours[triangle.shadeColour];
+		const int* ditherRow = SHADE_TABLE.dither[y & 3];
+		int ditherMask = ditherShading ? ~0 : 0;
+
+		for (int x = (int)firstColumn; x <= (int)lastColumn; ++x)
+		{
+			float z = rowZ + ((float)x * triangle.depthStepX);
+			if (z < depthBuffer[rowStart + x])
+			{
+				int level = (int)(rowLevel + ((float)x * triangle.levelStepX));
+				level = (level < 0) ? 0 : ((level >= SHADE_LEVELS) ? SHADE_LEVELS - 1 : level);
+				int step = (level + (ditherRow[x & 3] & ditherMask)) / SHADE_SUBSTEPS;
+				const Shade& shade = ramp[(step < SHADE_STEPS) ? step : SHADE_STEPS - 1];
+
+				depthBuffer[rowStart + x] = z;
+				screenBuffer[rowStart + x].Char.UnicodeChar = shade.character;
+				screenBuffer[rowStart + x].Attributes = shade.colour;
+			}
+		}
 	}
+}
 
-	CHAR_INFO character;
-	character.Char.UnicodeChar = sym;
-	character.Attributes = bgCol | fgCol;
-	return character;
+/*
+ * FillTexturedRow()
+ * Fills part of one row of a textured triangle. Dividing the texture coordinates by w for every cell would be slow, so it is only
+ * done at columns TEXTURE_SPAN apart, lined up on the screen rather than the row so tiles always agree, and the coordinates are
+ * stepped evenly in between in 16.16 fixed point, where wrapping around the texture is just dropping the whole part.
+ * The ends of each span are kept to cells inside the row, where w is always positive. Cells the texture leaves empty are see through.
+ * @param triangle The triangle, set up by SetupTriangle().
+ * @param y The row.
+ * @param sampleY The height of the centres of the row's cells.
+ * @param longX Where the row crosses the triangle's long edge.
+ * @param rowZ The depth the row would have in column 0.
+ * @param rowFirst The leftmost cell of the row inside the triangle.
+ * @param rowLast The rightmost cell of the row inside the triangle.
+ * @param firstColumn The leftmost cell to draw.
+ * @param lastColumn The rightmost cell to draw.
+ */
+void Engine::GameEngine::FillTexturedRow(const RasterTriangle& triangle, const int& y, const float& sampleY, const float& longX, const float& rowZ,
+										  const int& rowFirst, const int& rowLast, const int& firstColumn, const int& lastColumn)
+{
+	// Texture coordinates over w, and 1 / w, as they would be in column 0 of this row
+	float rowU = triangle.u0 + ((sampleY - triangle.y0) * triangle.longStepU) + ((0.5f - longX) * triangle.uStepX);
+	float rowV = triangle.v0 + ((sampleY - triangle.y0) * triangle.longStepV) + ((0.5f - longX) * triangle.vStepX);
+	float rowQ = triangle.q0 + ((sampleY - triangle.y0) * triangle.longStepQ) + ((0.5f - longX) * triangle.qStepX);
+
+	const short* pixels = triangle.texture->Pixels();
+	const short* colours = triangle.texture->Colours();
+	unsigned int textureWidth = (unsigned int)triangle.texture->TexelWidth();
+	unsigned int textureHeight = (unsigned int)triangle.texture->TexelHeight();
+	int rowStart = y * screenWidth;
+
+	int endColumn = 0;
+	bool haveEnd = false;
+	float endU = 0.0f, endV = 0.0f;
+
+	for (int x = firstColumn; x <= lastColumn;)
+	{
+		int spanStart = x & ~(TEXTURE_SPAN - 1);
+		int from = (spanStart > rowFirst) ? spanStart : rowFirst;
+		int to = (spanStart + TEXTURE_SPAN < rowLast) ? spanStart + TEXTURE_SPAN : rowLast;
+		int last = (spanStart + TEXTURE_SPAN - 1 < lastColumn) ? spanStart + TEXTURE_SPAN - 1 : lastColumn;
+
+		// The end of the last span is the start of this one
+		float fromU, fromV;
+		if (haveEnd && from == endColumn)
+		{
+			fromU = endU;
+			fromV = endV;
+		}
+		else
+		{
+			float w = 1.0f / (rowQ + ((float)from * triangle.qStepX));
+			fromU = (rowU + ((float)from * triangle.uStepX)) * w;
+			fromV = (rowV + ((float)from * triangle.vStepX)) * w;
+		}
+
+		float w = 1.0f / (rowQ + ((float)to * triangle.qStepX));
+		endU = (rowU + ((float)to * triangle.uStepX)) * w;
+		endV = (rowV + ((float)to * triangle.vStepX)) * w;
+		endColumn = to;
+		haveEnd = true;
+
+		float spanScale = TEXTURE_SPAN_RECIPROCALS[to - from] * TEXTURE_FIXED_ONE;
+		unsigned int stepU = (unsigned int)(int)((endU - fromU) * spanScale);
+		unsigned int stepV = (unsigned int)(int)((endV - fromV) * spanScale);
+		unsigned int u = (unsigned int)(int)((fromU - floorf(fromU)) * TEXTURE_FIXED_ONE) + ((unsigned int)(x - from) * stepU);
+		unsigned int v = (unsigned int)(int)((fromV - floorf(fromV)) * TEXTURE_FIXED_ONE) + ((unsigned int)(x - from) * stepV);
+
+		for (; x <= last; ++x, u += stepU, v += stepV)
+		{
+			float z = rowZ + ((float)x * triangle.depthStepX);
+			if (z < depthBuffer[rowStart + x])
+			{
+				unsigned int texel = ((((v & 0xFFFF) * textureHeight) >> 16) * textureWidth) + (((u & 0xFFFF) * textureWidth) >> 16);
+				short pixel = pixels[texel];
+				if (pixel != 0)
+				{
+					depthBuffer[rowStart + x] = z;
+					screenBuffer[rowStart + x].Char.UnicodeChar = pixel;
+					screenBuffer[rowStart + x].Attributes = colours[texel];
+				}
+			}
+		}
+	}
 }
\ No newline at end of file
@@ -1,14 +1,23 @@
 #pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <list>
+#include <mutex>
 #include <thread>
 
+#include "AllocationCounter.h"
 #include "Colour.h"
-#include "GameObject.h"
+#include "FrameArena.h"
+#include "GameObjectPool.h"
 #include "FVector2.h"
 #include "InputHandler.h"
 #include "RenderEngine.h"
+#include "ShadeTable.h"
 #include "Sprite.h"
+#include "ThreadPool.h"
 #include "Time.h"
+#include "Triangle.h"
 
 using namespace Engine::Graphics;
 using namespace Engine::Physics;
@@ -37,6 +46,49 @@ struct Vector2
 
 namespace Engine
 {
+	/*
+	 * FrameSlot
+	 * A finished frame passed from the simulation thread to the presenter thread.
+	 * Each slot carries its own size so frames from before and after a resize can't be mixed up.
+	 */
+	struct FrameSlot
+	{
+		CharInfo* cells;
+		int capacity;
+		int width;
+		int height;
+		int fontWidth;
+		int fontHeight;
+		int windowVersion;
+		std::wstring title;
+		FrameStats stats;
+	};
+
+	/*
+	 * RasterTriangle
+	 * A triangle set up for filling against the depth buffer: its points sorted top to bottom, how far its edges move per row
+	 * and how much its depth changes per column, and the cells it could cover. Setting up once lets it be drawn into several
+	 * tiles without repeating the work. Shaded triangles also carry their brightness, in shade levels, set up the same way as depth.
+	 * Textured triangles carry their texture coordinates divided by w, and 1 / w itself, which unlike the coordinates change linearly across the screen.
+	 */
+	struct RasterTriangle
+	{
+		float x0, y0, z0;
+		float x1, y1;
+		float longStepX, longStepZ;
+		float topStepX, bottomStepX;
+		float depthStepX;
+		float level0, longStepLevel, levelStepX;
+		float u0, longStepU, uStepX;
+		float v0, longStepV, vStepX;
+		float q0, longStepQ, qStepX;
+		const Sprite* texture;
+		int minX, minY, maxX, maxY;
+		short character;
+		short colour;
+		short shadeColour;
+	};
+
 	/*
 	 * GameEngine
 	 * An abstract class that defines a simple to implement framework for any game.
@@ -49,54 +101,144 @@ namespace Engine
 	private:
 		// Engine Functions
 		void ThreadUpdate(void);
+		void Tick(void);
+		void Render(const float& frameTime);
+		static void WaitUntil(const std::chrono::steady_clock::time_point& time);
+
+		// Presenter Functions
+		void PresentLoop(void);
+		bool PresentFrame(void);
 
 		// GameObject Handling Functions;
 		void RenderObjects(void);
+
+		// Dirty Rectangle Functions
+		int FindDirtySpans(const FrameSlot& frame);
+
+		// Rasterising Functions
+		bool SetupTriangle(const Triangle& triangle, RasterTriangle& setup) const;
+		void FillTriangleDepth(const RasterTriangle& triangle, const int& minX, const int& minY, const int& maxX, const int& maxY);
+		void FillTexturedRow(const RasterTriangle& triangle, const int& y, const float& sampleY, const float& longX, const float& rowZ,
+							  const int& rowFirst, const int& rowLast, const int& firstColumn, const int& lastColumn);
 	protected:
 		std::wstring appName;
 		int screenWidth;
 		int screenHeight;
-		CHAR_INFO* screenBuffer;
+		int fontWidth;
+		int fontHeight;
+		int windowVersion;
+		CharInfo* screenBuffer;
+		float* depthBuffer;
 		bool close;
 
-		std::list<GameObject*> objectPool;
+		// Game Loop Timing
+		float tickRate;
+		float renderRateCap;
+
+		// Headless Mode
+		bool headless;
+		int frameLimit;
+		int frameCount;
+
+		// Simulation To Presenter Handoff
+		FrameSlot frameSlots[3];
+		std::atomic<int> readySlot;
+		int simulationSlot;
+		int presentSlot;
+		std::atomic<bool> presenting;
+		std::mutex presentMutex;
+		std::condition_variable presentSignal;
+
+		// Dirty Rectangle Tracking (owned by the presenter)
+		int presentWindowVersion;
+		CharInfo* previousBuffer;
+		DirtySpan* dirtySpans;
+		int changedCells;
+		std::atomic<bool> forceFullRedraw;
+
+		GameObjectPool objectPool;
+
+		// Per Tick Memory
+		FrameArena frameArena;
+		unsigned long long allocationCount;
+		int frameAllocations;
+
+		// Rasterising
+		ThreadPool rasterPool;
+		bool ditherShading;
 
 		// Testing Time
 		std::chrono::time_point<std::chrono::system_clock> beforeTime;
 		std::chrono::time_point<std::chrono::system_clock> afterTime;
 
 		float runGameTime = 0.0f;
-		float renderTime = 0.0f;
+		std::atomic<float> renderTime;
 
 		// Virtual Game Functions
 		virtual bool CreateGame(void) = 0;
 		virtual bool RunGame(void) = 0;
+
+		// Screen Functions
+		void ResizeScreen(const int& width, const int& height, const int& fontWidth, const int& fontHeight);
 	public:
 		GameEngine(std::wstring name = L"GameEngine", int width = 80, int height = 30, int fontWidth = 8, int fontHeight = 16);
 		~GameEngine(void);
 
 		// Startup game - generate all assets needed
 		void Start(void);
+		void RunHeadless(const int& frames, const float& fixedStep = 1.0f / 60.0f);
+
+		// Game Loop Timing
+		float TickRate(void) const;
+		void SetTickRate(const float& ticksPerSecond);
+		float RenderRateCap(void) const;
+		void SetRenderRateCap(const float& framesPerSecond);
+
+		// Frame Statistics
+		int ChangedCells(void) const;
+		int FrameCount(void) const;
+		int FrameAllocations(void) const;
+
+		// Screen Access
+		int ScreenWidth(void) const;
+		int ScreenHeight(void) const;
+		CharInfo* ScreenBuffer(void);
+
+		// Per Tick Memory
+		FrameArena& Arena(void);
+
+		// Rasterising
+		ThreadPool& RasterPool(void);
+		bool ShadeDithering(void) const;
+		void SetShadeDithering(const bool& dither);
 
 		// GameObject Handling Functions
-		GameObject* CreateGameObject(float x, float y, Sprite* sprite);
-		GameObject* CreateGameObject(FVector2 position, Sprite* sprite);
+		GameObjectHandle CreateGameObject(float x, float y, Sprite* sprite);
+		GameObjectHandle CreateGameObject(FVector2 position, Sprite* sprite);
+		bool DestroyGameObject(const GameObjectHandle& handle);
+		GameObjectPool& GameObjects(void);
 
 		// Draw Functions
 		void ClearScreen();
+		void ClearDepth();
 		void DrawChar(const int& x, const int& y, const short& character = PIXEL_SOLID, const short& colour = FG_WHITE);
 		void DrawLine(int x0,  int y0, const int& x1, const int& y1, const short& character = PIXEL_SOLID, const short& colour = FG_WHITE);
 		void DrawTriangle(const int& x0, const int& y0, const int& x1, const int& y1, const int& x2, const int& y2, const short& character = PIXEL_SOLID, const short& colour = FG_WHITE);
 		void DrawFillTriangle(int x0, int y0, int x1, int y1, int x2, int y2, const short& character = PIXEL_SOLID, const short& colour = FG_WHITE);
+		void DrawFillTriangleDepth(float x0, float y0, float z0, float x1, float y1, float z1, float x2, float y2, float z2, const short& character = PIXEL_SOLID, const short& colour = FG_WHITE);
+		void DrawFillTrianglesDepth(const Triangle* triangles, const size_t& count);
 		void DrawRect(const int& minX, const int& minY, const int& maxX, const int& maxY, const short& character = PIXEL_SOLID, const short& colour = FG_WHITE);
 		void DrawRectFill(const int& minX, const int& minY, const int& maxX, const int& maxY, const short& borderCharacter = PIXEL_SOLID, const short& borderColour = FG_WHITE, const short& fillCharacter = ' ', const short& fillColour = FG_BLACK);
 		void DrawString(const int& x, const int& y, const std::wstring& msg, const short& colour = FG_WHITE);
+		void DrawString(const int& x, const int& y, const wchar_t* msg, const short& colour = FG_WHITE);
 		void DrawStringAlpha(const int& x, const int& y, const std::wstring& msg, const short& colour = FG_WHITE);
+		void DrawStringAlpha(const int& x, const int& y, const wchar_t* msg, const short& colour = FG_WHITE);
 		void DrawCircle(const int& centreX, const int& centreY, const int& radius, const short& character = PIXEL_SOLID, const short& colour = FG_WHITE);
 		void DrawSprite(const int& x, const int& y, const Sprite& sprite);
 		void DrawPartialSprite(const int& x, const int& y, const int& minX, const int& minY, const int& maxX, const int& maxY, const Sprite& sprite);
+		void ForceFullRedraw(void);
 
-		CHAR_INFO GetGreyScaleColour(const float& lum);
-		CHAR_INFO GetColour(const short& baseColour, const float& lum);
+		CharInfo GetGreyScaleColour(const float& lum);
+		CharInfo GetColour(const short& baseColour, const float& lum);
 	};
 }
\ No newline at end of file
@@ -0,0 +1,234 @@
+#include <utility>
+
+#include "GameObjectPool.h"
+
+// Marks the end of the free slot list
+static const unsigned int NO_SLOT = 0xFFFFFFFF;
+
+/**
+ * Constructor
+ */
+Engine::GameObjectPool::GameObjectPool() : freeSlot(NO_SLOT), activeCount(0) { }
+
+/**
+ * Destructor
+ */
+Engine::GameObjectPool::~GameObjectPool() { }
+
+// LIFETIME FUNCTIONS ########################################################################################################################################
+
+/**
+ * Create()
+ * Adds a new active GameObject to the pool, reusing a free slot if there is one.
+ * @param position The position of the GameObject in world and screen space.
+ * @param sprite The sprite to be displayed.
+ * @return The handle to the new GameObject.
+ */
+Engine::GameObjectHandle Engine::GameObjectPool::Create(const FVector2& position, Sprite* sprite)
+{
+	unsigned int slotIndex;
+	if (freeSlot != NO_SLOT)
+	{
+		slotIndex = freeSlot;
+		freeSlot = slots[slotIndex].denseIndex;
+	}
+	else
+	{
+		slotIndex = (unsigned int)slots.size();
+		slots.push_back({ 0, 1 });
+	}
+
+	unsigned int denseIndex = (unsigned int)sprites.size();
+	worldPositions.push_back(position);
+	screenPositions.push_back(position);
+	previousScreenPositions.push_back(position);
+	sprites.push_back(sprite);
+	slotIndices.push_back(slotIndex);
+	slots[slotIndex].denseIndex = denseIndex;
+
+	// Move it to the end of the active GameObjects
+	Swap(denseIndex, activeCount);
+	++activeCount;
+
+	return { slotIndex, slots[slotIndex].generation };
+}
+
+/**
+ * Destroy()
+ * Removes a GameObject from the pool. Any handles to it stop being valid.
+ * @param handle The GameObject to remove.
+ * @return True if the handle was valid and the GameObject was removed.
+ */
+bool Engine::GameObjectPool::Destroy(const GameObjectHandle& handle)
+{
+	if (!IsValid(handle))
+		return false;
+
+	// Deactivate it then move it to the end so it can be popped off
+	SetActive(handle, false);
+	Swap(slots[handle.index].denseIndex, (unsigned int)sprites.size() - 1);
+
+	worldPositions.pop_back();
+	screenPositions.pop_back();
+	previousScreenPositions.pop_back();
+	sprites.pop_back();
+	slotIndices.pop_back();
+
+	Slot& slot = slots[handle.index];
+	++slot.generation;
+	slot.denseIndex = freeSlot;
+	freeSlot = handle.index;
+
+	return true;
+}
+
+/**
+ * IsValid()
+ * @param handle The handle to check.
+ * @return True if the handle refers to a GameObject that hasn't been destroyed.
+ */
+bool Engine::GameObjectPool::IsValid(const GameObjectHandle& handle) const
+{
+	return handle.index < slots.size() && slots[handle.index].generation == handle.generation;
+}
+
+/**
+ * Clear()
+ * Destroys every GameObject in the pool.
+ */
+void Engine::GameObjectPool::Clear()
+{
+	while (!slotIndices.empty())
+	{
+		unsigned int slotIndex = slotIndices.back();
+		Destroy({ slotIndex, slots[slotIndex].generation });
+	}
+}
+
+/**
+ * Swap()
+ * Swaps two GameObjects in the arrays and updates their slots to match.
+ * @param a The array index of the first GameObject.
+ * @param b The array index of the second GameObject.
+ */
+void Engine::GameObjectPool::Swap(const unsigned int& a, const unsigned int& b)
+{
+	if (a == b)
+		return;
+
+	std::swap(worldPositions[a], worldPositions[b]);
+	std::swap(screenPositions[a], screenPositions[b]);
+	std::swap(previousScreenPositions[a], previousScreenPositions[b]);
+	std::swap(sprites[a], sprites[b]);
+	std::swap(slotIndices[a], slotIndices[b]);
+
+	slots[slotIndices[a]].denseIndex = a;
+	slots[slotIndices[b]].denseIndex = b;
+}
+
+// GAMEOBJECT FUNCTIONS ######################################################################################################################################
+
+/**
+ * IsActive()
+ * @param handle The GameObject to check.
+ * @return True if the GameObject is being drawn.
+ */
+bool Engine::GameObjectPool::IsActive(const GameObjectHandle& handle) const { return slots[handle.index].denseIndex < activeCount; }
+
+/**
+ * SetActive()
+ * Activates or deactivates a GameObject by moving it across the boundary between the active and inactive GameObjects.
+ * @param handle The GameObject to change.
+ * @param active True to draw the GameObject, false to hide it.
+ */
+void Engine::GameObjectPool::SetActive(const GameObjectHandle& handle, const bool& active)
+{
+	if (IsActive(handle) == active)
+		return;
+
+	if (active)
+	{
+		Swap(slots[handle.index].denseIndex, activeCount);
+		++activeCount;
+	}
+	else
+	{
+		--activeCount;
+		Swap(slots[handle.index].denseIndex, activeCount);
+	}
+}
+
+/**
+ * WorldPosition()
+ * @param handle The GameObject to get the position of.
+ * @return The position of the GameObject in the world, which can be changed.
+ */
+Engine::Physics::FVector2& Engine::GameObjectPool::WorldPosition(const GameObjectHandle& handle) { return worldPositions[slots[handle.index].denseIndex]; }
+
+/**
+ * ScreenPosition()
+ * @param handle The GameObject to get the position of.
+ * @return The position the GameObject is drawn at on the screen, which can be changed.
+ */
+Engine::Physics::FVector2& Engine::GameObjectPool::ScreenPosition(const GameObjectHandle& handle) { return screenPositions[slots[handle.index].denseIndex]; }
+
+/**
+ * PreviousScreenPosition()
+ * Set this along with the screen position to move a GameObject without it sliding there between ticks.
+ * @param handle The GameObject to get the position of.
+ * @return The screen position of the GameObject at the previous simulation tick, which can be changed.
+ */
+Engine::Physics::FVector2& Engine::GameObjectPool::PreviousScreenPosition(const GameObjectHandle& handle) { return previousScreenPositions[slots[handle.index].denseIndex]; }
+
+/**
+ * GetSprite()
+ * @param handle The GameObject to get the sprite of.
+ * @return Pointer to the sprite (could be NULL).
+ */
+Sprite* Engine::GameObjectPool::GetSprite(const GameObjectHandle& handle) const { return sprites[slots[handle.index].denseIndex]; }
+
+/**
+ * SetSprite()
+ * @param handle The GameObject to change.
+ * @param sprite Pointer to the sprite to display (will accept NULL).
+ */
+void Engine::GameObjectPool::SetSprite(const GameObjectHandle& handle, Sprite* sprite) { sprites[slots[handle.index].denseIndex] = sprite; }
+
+// BULK FUNCTIONS ############################################################################################################################################
+
+/**
+ * Count()
+ * @return The number of GameObjects in the pool.
+ */
+unsigned int Engine::GameObjectPool::Count() const { return (unsigned int)sprites.size(); }
+
+/**
+ * ActiveCount()
+ * @return The number of active GameObjects, which are the first entries of each array.
+ */
+unsigned int Engine::GameObjectPool::ActiveCount() const { return activeCount; }
+
+/**
+ * ScreenPositions()
+ * @return The screen positions of every GameObject, active ones first.
+ */
+const Engine::Physics::FVector2* Engine::GameObjectPool::ScreenPositions() const { return screenPositions.data(); }
+
+/**
+ * PreviousScreenPositions()
+ * @return The screen positions of every GameObject at the previous simulation tick, active ones first.
+ */
+const Engine::Physics::FVector2* Engine::GameObjectPool::PreviousScreenPositions() const { return previousScreenPositions.data(); }
+
+/**
+ * Sprites()
+ * @return The sprites of every GameObject, active ones first.
+ */
+Sprite* const* Engine::GameObjectPool::Sprites() const { return sprites.data(); }
+
+/**
+ * StorePreviousScreenPositions()
+ * Records where every GameObject is on the screen, called at the start of each simulation tick
+ * so frames can be drawn between the previous tick and the current one.
+ */
+void Engine::GameObjectPool::StorePreviousScreenPositions() { previousScreenPositions = screenPositions; }
\ No newline at end of file
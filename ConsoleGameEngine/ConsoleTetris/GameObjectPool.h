@@ -0,0 +1,85 @@
+#pragma once
+#include <vector>
+
+#include "FVector2.h"
+#include "Sprite.h"
+
+using namespace Engine::Graphics;
+
+namespace Engine
+{
+	/**
+	 * GameObjectHandle
+	 * Refers to a GameObject in a GameObjectPool.
+	 * A handle stays the same for the life of its GameObject, and stops being valid once the GameObject is destroyed,
+	 * even if its slot is reused. A default constructed handle is never valid.
+	 */
+	struct GameObjectHandle
+	{
+		unsigned int index = 0;
+		unsigned int generation = 0;
+	};
+
+	/**
+	 * GameObjectPool
+	 * Stores all the GameObjects of a game as a slot map.
+	 * Each part of a GameObject is kept in its own contiguous array, with the active GameObjects packed at the front,
+	 * so drawing walks straight through the active ones without chasing pointers or skipping inactive ones.
+	 * Handles point at slots which point into the arrays, so GameObjects can be moved around as they are
+	 * created, destroyed, activated and deactivated, all in constant time.
+	 */
+	class GameObjectPool
+	{
+	private:
+		/**
+		 * Slot
+		 * Where a handle's GameObject currently is in the arrays.
+		 * While the slot is free denseIndex holds the next free slot instead.
+		 */
+		struct Slot
+		{
+			unsigned int denseIndex;
+			unsigned int generation;
+		};
+
+		std::vector<Slot> slots;
+		unsigned int freeSlot;
+
+		// GameObject Data - index i of each array belongs to the same GameObject
+		std::vector<FVector2> worldPositions;
+		std::vector<FVector2> screenPositions;
+		std::vector<FVector2> previousScreenPositions;
+		std::vector<Sprite*> sprites;
+		std::vector<unsigned int> slotIndices;
+		unsigned int activeCount;
+
+		void Swap(const unsigned int& a, const unsigned int& b);
+
+	public:
+		GameObjectPool(void);
+		~GameObjectPool(void);
+
+		// Lifetime Functions
+		GameObjectHandle Create(const FVector2& position, Sprite* sprite = nullptr);
+		bool Destroy(const GameObjectHandle& handle);
+		bool IsValid(const GameObjectHandle& handle) const;
+		void Clear(void);
+
+		// GameObject Functions - the handle must be valid
+		bool IsActive(const GameObjectHandle& handle) const;
+		void SetActive(const GameObjectHandle& handle, const bool& active);
+		FVector2& WorldPosition(const GameObjectHandle& handle);
+		FVector2& ScreenPosition(const GameObjectHandle& handle);
+		FVector2& PreviousScreenPosition(const GameObjectHandle& handle);
+		Sprite* GetSprite(const GameObjectHandle& handle) const;
+		void SetSprite(const GameObjectHandle& handle, Sprite* sprite);
+
+		// Bulk Functions - the active GameObjects are the first ActiveCount() entries of each array
+		unsigned int Count(void) const;
+		unsigned int ActiveCount(void) const;
+		const FVector2* ScreenPositions(void) const;
+		const FVector2* PreviousScreenPositions(void) const;
+		Sprite* const* Sprites(void) const;
+		void StorePreviousScreenPositions(void);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,578 @@
+#include <cmath>
+#include <cstring>
+
+#include "HashLife.h"
+
+// Marks a node that hasn't got a child or a cached result
+static const uint32_t NO_NODE = 0xFFFFFFFF;
+
+// The dead and alive cells, the only level 0 nodes
+static const uint32_t DEAD_CELL = 0;
+static const uint32_t LIVE_CELL = 1;
+
+// The biggest the universe can grow, keeping every coordinate inside an int64_t
+static const int MAX_LEVEL = 62;
+
+// The most generations a single Step() can skip, as a power of 2
+static const int MAX_STEP_LOG2 = MAX_LEVEL - 4;
+
+// NODE BUILDING ###############################################################################################################################################
+
+/*
+ * NodeKeyHash()
+ * @param key The four children of a node.
+ * @return The key's hash.
+ */
+size_t Engine::HashLife::NodeKeyHash::operator()(const NodeKey& key) const
+{
+	uint64_t hash = key.nw;
+	hash = (hash * 0x9E3779B97F4A7C15ULL) ^ key.ne;
+	hash = (hash * 0x9E3779B97F4A7C15ULL) ^ key.sw;
+	hash = (hash * 0x9E3779B97F4A7C15ULL) ^ key.se;
+	return (size_t)(hash ^ (hash >> 32));
+}
+
+/*
+ * Join()
+ * Finds the node made of four squares, making it if it doesn't exist yet.
+ * @param nw, ne, sw, se The node's quarters, all on the same level.
+ * @return The one node with those quarters.
+ */
+Engine::HashLife::NodeID Engine::HashLife::Join(const NodeID& nw, const NodeID& ne, const NodeID& sw, const NodeID& se)
+{
+	NodeKey key = { nw, ne, sw, se };
+	std::unordered_map<NodeKey, NodeID, NodeKeyHash>::iterator existing = lookup.find(key);
+	if (existing != lookup.end())
+		return existing->second;
+
+	Node node;
+	node.nw = nw;
+	node.ne = ne;
+	node.sw = sw;
+	node.se = se;
+	node.result = NO_NODE;
+	node.level = nodes[nw].level + 1;
+	node.resultStep = -1;
+	node.population = nodes[nw].population + nodes[ne].population + nodes[sw].population + nodes[se].population;
+
+	NodeID id = (NodeID)nodes.size();
+	nodes.push_back(node);
+	lookup.emplace(key, id);
+	return id;
+}
+
+/*
+ * Empty()
+ * @param level The level of the node.
+ * @return The node with every cell dead.
+ */
+Engine::HashLife::NodeID Engine::HashLife::Empty(const int& level)
+{
+	while ((int)emptyNodes.size() <= level)
+	{
+		NodeID below = emptyNodes.back();
+		emptyNodes.push_back(Join(below, below, below, below));
+	}
+	return emptyNodes[level];
+}
+
+/*
+ * Centre()
+ * @param node A node of level 2 or more.
+ * @return The square half the size sitting in the middle of the node.
+ */
+Engine::HashLife::NodeID Engine::HashLife::Centre(const NodeID& node)
+{
+	const Node& n = nodes[node];
+	return Join(nodes[n.nw].se, nodes[n.ne].sw, nodes[n.sw].ne, nodes[n.se].nw);
+}
+
+/*
+ * Expand()
+ * @param node The node to expand.
+ * @return A node twice the size with the given one in its middle and dead cells all around.
+ */
+Engine::HashLife::NodeID Engine::HashLife::Expand(const NodeID& node)
+{
+	Node n = nodes[node];
+	NodeID border = Empty(n.level - 1);
+	return Join(Join(border, border, border, n.nw), Join(border, border, n.ne, border), Join(border, n.sw, border, border), Join(n.se, border, border, border));
+}
+
+/*
+ * SetCell()
+ * @param node The node to change.
+ * @param x, y The cell, from the node's top left corner.
+ * @param alive Whether the cell should be alive.
+ * @return The node with the cell changed.
+ */
+Engine::HashLife::NodeID Engine::HashLife::SetCell(const NodeID& node, const int64_t& x, const int64_t& y, const bool& alive)
+{
+	Node n = nodes[node];
+	if (n.level == 0)
+		return alive ? LIVE_CELL : DEAD_CELL;
+
+	int64_t half = (int64_t)1 << (n.level - 1);
+	if (y < half)
+	{
+		if (x < half)
+			return Join(SetCell(n.nw, x, y, alive), n.ne, n.sw, n.se);
+		return Join(n.nw, SetCell(n.ne, x - half, y, alive), n.sw, n.se);
+	}
+	if (x < half)
+		return Join(n.nw, n.ne, SetCell(n.sw, x, y - half, alive), n.se);
+	return Join(n.nw, n.ne, n.sw, SetCell(n.se, x - half, y - half, alive));
+}
+
+// EVOLUTION ###################################################################################################################################################
+
+/*
+ * Successor()
+ * Works out the middle of a node some generations on, caching it on the node.
+ * At full speed (step = level - 2) the node is split into nine overlapping squares which are each run forward a quarter of the node's size,
+ * then joined four at a time and run forward the same again. Slower steps take the middle of the nine squares instead of the first run.
+ * @param node The node, level 2 or more.
+ * @param step How far on to go, 2^step generations. No more than the node's level - 2.
+ * @return The node's middle square, half its size, 2^step generations on.
+ */
+Engine::HashLife::NodeID Engine::HashLife::Successor(const NodeID& node, const int& step)
+{
+	Node n = nodes[node];
+	if (n.population == 0)
+		return Empty(n.level - 1);
+	if (n.result != NO_NODE && n.resultStep == step)
+		return n.result;
+
+	NodeID result;
+	if (n.level == 2)
+		result = BaseSuccessor(node);
+	else
+	{
+		Node nw = nodes[n.nw], ne = nodes[n.ne], sw = nodes[n.sw], se = nodes[n.se];
+
+		// The nine overlapping squares, each half the size of the node
+		NodeID squares[9] =
+		{
+			n.nw, Join(nw.ne, ne.nw, nw.se, ne.sw), n.ne,
+			Join(nw.sw, nw.se, sw.nw, sw.ne), Join(nw.se, ne.sw, sw.ne, se.nw), Join(ne.sw, ne.se, se.nw, se.ne),
+			n.sw, Join(sw.ne, se.nw, sw.se, se.sw), n.se
+		};
+
+		int innerStep = n.level - 3;
+		if (step == n.level - 2)
+		{
+			for (int i = 0; i < 9; ++i)
+				squares[i] = Successor(squares[i], innerStep);
+		}
+		else
+		{
+			innerStep = step;
+			for (int i = 0; i < 9; ++i)
+				squares[i] = Centre(squares[i]);
+		}
+
+		NodeID resultNW = Successor(Join(squares[0], squares[1], squares[3], squares[4]), innerStep);
+		NodeID resultNE = Successor(Join(squares[1], squares[2], squares[4], squares[5]), innerStep);
+		NodeID resultSW = Successor(Join(squares[3], squares[4], squares[6], squares[7]), innerStep);
+		NodeID resultSE = Successor(Join(squares[4], squares[5], squares[7], squares[8]), innerStep);
+		result = Join(resultNW, resultNE, resultSW, resultSE);
+	}
+
+	nodes[node].result = result;
+	nodes[node].resultStep = (int8_t)step;
+	return result;
+}
+
+/*
+ * BaseSuccessor()
+ * Runs a 4x4 node on one generation by looking it up in the rule's table.
+ * @param node A level 2 node.
+ * @return The middle 2x2 cells one generation on.
+ */
+Engine::HashLife::NodeID Engine::HashLife::BaseSuccessor(const NodeID& node)
+{
+	const Node& n = nodes[node];
+	const NodeID quarters[4] = { n.nw, n.ne, n.sw, n.se };
+
+	// Bit x + y * 4 holds the cell at x, y
+	unsigned int cells = 0;
+	for (int q = 0; q < 4; ++q)
+	{
+		const Node& quarter = nodes[quarters[q]];
+		int x = (q % 2) * 2, y = (q / 2) * 2;
+		cells |= (quarter.nw == LIVE_CELL ? 1u : 0u) << (x + (y * 4));
+		cells |= (quarter.ne == LIVE_CELL ? 1u : 0u) << (x + 1 + (y * 4));
+		cells |= (quarter.sw == LIVE_CELL ? 1u : 0u) << (x + ((y + 1) * 4));
+		cells |= (quarter.se == LIVE_CELL ? 1u : 0u) << (x + 1 + ((y + 1) * 4));
+	}
+
+	unsigned char next = baseResults[cells];
+	return Join((next & 1) ? LIVE_CELL : DEAD_CELL, (next & 2) ? LIVE_CELL : DEAD_CELL, (next & 4) ? LIVE_CELL : DEAD_CELL, (next & 8) ? LIVE_CELL : DEAD_CELL);
+}
+
+/*
+ * Contained()
+ * @param node A node of level 2 or more.
+ * @return True if every living cell is in the middle half of the node.
+ */
+bool Engine::HashLife::Contained(const NodeID& node) const
+{
+	const Node& n = nodes[node];
+	return nodes[nodes[n.nw].se].population + nodes[nodes[n.ne].sw].population + nodes[nodes[n.sw].ne].population + nodes[nodes[n.se].nw].population == n.population;
+}
+
+// MEMORY ######################################################################################################################################################
+
+/*
+ * Mark()
+ * Flags a node and everything it's made of as still in use.
+ * @param node The node.
+ * @param reachable One flag per node.
+ * @param followResults Whether the node's cached result should be kept as well.
+ */
+void Engine::HashLife::Mark(const NodeID& node, std::vector<bool>& reachable, const bool& followResults) const
+{
+	if (reachable[node])
+		return;
+	reachable[node] = true;
+
+	const Node& n = nodes[node];
+	if (n.level == 0)
+		return;
+
+	Mark(n.nw, reachable, followResults);
+	Mark(n.ne, reachable, followResults);
+	Mark(n.sw, reachable, followResults);
+	Mark(n.se, reachable, followResults);
+	if (followResults && n.result != NO_NODE)
+		Mark(n.result, reachable, followResults);
+}
+
+/*
+ * Collect()
+ * Throws away every node the universe no longer uses. Cached results are kept while they fit in half the threshold,
+ * after that they are dropped too, and if the universe alone doesn't fit the threshold is raised.
+ */
+void Engine::HashLife::Collect()
+{
+	std::vector<bool> reachable(nodes.size(), false);
+	size_t kept = 0;
+	for (int pass = 0; pass < 2; ++pass)
+	{
+		bool followResults = pass == 0;
+		reachable.assign(nodes.size(), false);
+		reachable[DEAD_CELL] = true;
+		reachable[LIVE_CELL] = true;
+		for (size_t i = 0; i < emptyNodes.size(); ++i)
+			Mark(emptyNodes[i], reachable, followResults);
+		Mark(root, reachable, followResults);
+
+		kept = 0;
+		for (size_t i = 0; i < reachable.size(); ++i)
+			kept += reachable[i] ? 1 : 0;
+		if (kept <= collectThreshold / 2)
+			break;
+	}
+
+	// Nodes are always made after their children, so keeping the order lets children be renumbered on the way
+	std::vector<NodeID> remap(nodes.size(), NO_NODE);
+	std::vector<Node> survivors;
+	survivors.reserve(kept);
+	for (size_t i = 0; i < nodes.size(); ++i)
+	{
+		if (!reachable[i])
+			continue;
+
+		Node node = nodes[i];
+		if (node.level > 0)
+		{
+			node.nw = remap[node.nw];
+			node.ne = remap[node.ne];
+			node.sw = remap[node.sw];
+			node.se = remap[node.se];
+		}
+		remap[i] = (NodeID)survivors.size();
+		survivors.push_back(node);
+	}
+
+	lookup.clear();
+	lookup.reserve(survivors.size());
+	for (size_t i = 0; i < survivors.size(); ++i)
+	{
+		Node& node = survivors[i];
+		node.result = (node.result != NO_NODE) ? remap[node.result] : NO_NODE;
+		if (node.result == NO_NODE)
+			node.resultStep = -1;
+		if (node.level > 0)
+		{
+			NodeKey key = { node.nw, node.ne, node.sw, node.se };
+			lookup.emplace(key, (NodeID)i);
+		}
+	}
+
+	nodes.swap(survivors);
+	for (size_t i = 0; i < emptyNodes.size(); ++i)
+		emptyNodes[i] = remap[emptyNodes[i]];
+	root = remap[root];
+
+	if (nodes.size() > collectThreshold / 2)
+		collectThreshold = nodes.size() * 2;
+}
+
+// QUERIES #####################################################################################################################################################
+
+/*
+ * GetCell()
+ * @param node The node to look in.
+ * @param x, y The cell, from the node's top left corner.
+ * @return True if the cell is alive.
+ */
+bool Engine::HashLife::GetCell(const NodeID& node, int64_t x, int64_t y) const
+{
+	NodeID current = node;
+	while (nodes[current].level > 0)
+	{
+		const Node& n = nodes[current];
+		if (n.population == 0)
+			return false;
+
+		int64_t half = (int64_t)1 << (n.level - 1);
+		bool east = x >= half, south = y >= half;
+		current = south ? (east ? n.se : n.sw) : (east ? n.ne : n.nw);
+		x -= east ? half : 0;
+		y -= south ? half : 0;
+	}
+	return current == LIVE_CELL;
+}
+
+/*
+ * RenderNode()
+ * Adds a node's living cells to the pixels they land on, skipping empty nodes and ones outside the view.
+ * @param node The node.
+ * @param x, y The node's top left cell.
+ * @param left, top, zoom, columns, rows, coverage See Render().
+ */
+void Engine::HashLife::RenderNode(const NodeID& node, const int64_t& x, const int64_t& y, const int64_t& left, const int64_t& top, const int& zoom, const int& columns, const int& rows, float* coverage) const
+{
+	const Node& n = nodes[node];
+	if (n.population == 0)
+		return;
+
+	// The view in cells, rounded out to whole cells when zoomed in
+	int64_t viewWidth = (zoom >= 0) ? ((int64_t)columns << zoom) : (((int64_t)columns + (1 << -zoom) - 1) >> -zoom);
+	int64_t viewHeight = (zoom >= 0) ? ((int64_t)rows << zoom) : (((int64_t)rows + (1 << -zoom) - 1) >> -zoom);
+	int64_t size = (int64_t)1 << n.level;
+	if (x >= left + viewWidth || y >= top + viewHeight || x + size <= left || y + size <= top)
+		return;
+
+	if (zoom >= 0 && n.level <= zoom)
+	{
+		// A whole node in one pixel
+		int64_t pixelX = (x - left) >> zoom, pixelY = (y - top) >> zoom;
+		if (pixelX >= 0 && pixelX < columns && pixelY >= 0 && pixelY < rows)
+			coverage[(pixelY * columns) + pixelX] += (float)n.population * ldexpf(1.0f, -2 * zoom);
+		return;
+	}
+
+	if (n.level == 0)
+	{
+		// A single cell over a block of pixels
+		int scale = 1 << -zoom;
+		int pixelX = (int)(x - left) * scale, pixelY = (int)(y - top) * scale;
+		for (int py = (pixelY < 0 ? 0 : pixelY); py < pixelY + scale && py < rows; ++py)
+			for (int px = (pixelX < 0 ? 0 : pixelX); px < pixelX + scale && px < columns; ++px)
+				coverage[(py * columns) + px] = 1.0f;
+		return;
+	}
+
+	int64_t half = size / 2;
+	RenderNode(n.nw, x, y, left, top, zoom, columns, rows, coverage);
+	RenderNode(n.ne, x + half, y, left, top, zoom, columns, rows, coverage);
+	RenderNode(n.sw, x, y + half, left, top, zoom, columns, rows, coverage);
+	RenderNode(n.se, x + half, y + half, left, top, zoom, columns, rows, coverage);
+}
+
+// UNIVERSE ####################################################################################################################################################
+
+/**
+ * Constructor
+ * @param collectThreshold How many nodes there can be before unused ones are thrown away.
+ */
+Engine::HashLife::HashLife(const size_t& collectThreshold) : stepLog2(0), collectThreshold(collectThreshold)
+{
+	Clear();
+	SetRule(LifeRule());
+}
+
+/*
+ * Clear()
+ * Kills every cell, throws away every node and sets the generation back to 0.
+ */
+void Engine::HashLife::Clear()
+{
+	nodes.clear();
+	lookup.clear();
+	emptyNodes.clear();
+
+	Node cell;
+	memset(&cell, 0, sizeof(Node));
+	cell.nw = cell.ne = cell.sw = cell.se = NO_NODE;
+	cell.result = NO_NODE;
+	cell.resultStep = -1;
+	nodes.push_back(cell);
+	cell.population = 1;
+	nodes.push_back(cell);
+
+	emptyNodes.push_back(DEAD_CELL);
+	root = Empty(3);
+	generation = 0;
+}
+
+/*
+ * SetRule()
+ * Changes the rule the universe runs under, building the table of every 4x4 square's middle one generation on
+ * and throwing away every cached result.
+ * @param rule The new rule.
+ * @return False if the rule has B0, which would bring the infinite empty space around the universe to life, in which case nothing changes.
+ */
+bool Engine::HashLife::SetRule(const LifeRule& rule)
+{
+	if (rule.BirthMask() & 1)
+		return false;
+	this->rule = rule;
+
+	// Bit x + y * 4 of the index holds the cell at x, y, and bits 0 to 3 of the result the middle cells, top left first
+	baseResults.assign(1 << 16, 0);
+	for (unsigned int cells = 0; cells < (1u << 16); ++cells)
+	{
+		unsigned char next = 0;
+		for (int i = 0; i < 4; ++i)
+		{
+			int x = 1 + (i % 2), y = 1 + (i / 2);
+			int count = 0;
+			for (int dy = -1; dy <= 1; ++dy)
+				for (int dx = -1; dx <= 1; ++dx)
+					if (dx != 0 || dy != 0)
+						count += (cells >> ((x + dx) + ((y + dy) * 4))) & 1;
+
+			bool alive = ((cells >> (x + (y * 4))) & 1) != 0;
+			unsigned short mask = alive ? rule.SurvivalMask() : rule.BirthMask();
+			if ((mask >> count) & 1)
+				next |= (unsigned char)(1 << i);
+		}
+		baseResults[cells] = next;
+	}
+
+	for (size_t i = 0; i < nodes.size(); ++i)
+	{
+		nodes[i].result = NO_NODE;
+		nodes[i].resultStep = -1;
+	}
+	return true;
+}
+
+/*
+ * Rule()
+ * @return The rule the universe runs under.
+ */
+const Engine::LifeRule& Engine::HashLife::Rule() const { return rule; }
+
+/*
+ * Get()
+ * @param x, y The cell, with 0, 0 in the middle of the universe.
+ * @return True if the cell is alive.
+ */
+bool Engine::HashLife::Get(const int64_t& x, const int64_t& y) const
+{
+	int64_t half = (int64_t)1 << (nodes[root].level - 1);
+	if (x < -half || x >= half || y < -half || y >= half)
+		return false;
+	return GetCell(root, x + half, y + half);
+}
+
+/*
+ * Set()
+ * Brings a cell to life or kills it, growing the universe if the cell is outside it.
+ * @param x, y The cell, with 0, 0 in the middle of the universe.
+ * @param alive Whether the cell should be alive.
+ */
+void Engine::HashLife::Set(const int64_t& x, const int64_t& y, const bool& alive)
+{
+	int64_t half = (int64_t)1 << (nodes[root].level - 1);
+	while (x < -half || x >= half || y < -half || y >= half)
+	{
+		if (nodes[root].level >= MAX_LEVEL)
+			return;
+		root = Expand(root);
+		half *= 2;
+	}
+	root = SetCell(root, x + half, y + half, alive);
+}
+
+/*
+ * SetStepLog2()
+ * @param stepLog2 How many generations each Step() moves on, as a power of 2.
+ */
+void Engine::HashLife::SetStepLog2(const int& stepLog2)
+{
+	this->stepLog2 = (stepLog2 < 0) ? 0 : (stepLog2 > MAX_STEP_LOG2) ? MAX_STEP_LOG2 : stepLog2;
+}
+
+/*
+ * StepLog2()
+ * @return How many generations each Step() moves on, as a power of 2.
+ */
+int Engine::HashLife::StepLog2() const { return stepLog2; }
+
+/*
+ * Step()
+ * Moves the universe on 2^StepLog2() generations.
+ * The universe is first grown until the living cells sit in its middle quarter, leaving room for them to spread
+ * as far as they possibly can in that many generations, then replaced by its successor.
+ */
+void Engine::HashLife::Step()
+{
+	while (nodes[root].level < MAX_LEVEL - 1 && (nodes[root].level < stepLog2 + 2 || !Contained(root)))
+		root = Expand(root);
+	root = Expand(root);
+
+	root = Successor(root, stepLog2);
+	generation += (uint64_t)1 << stepLog2;
+
+	if (nodes.size() > collectThreshold)
+		Collect();
+}
+
+/*
+ * Generation()
+ * @return How many generations the universe has been run for since it was cleared.
+ */
+uint64_t Engine::HashLife::Generation() const { return generation; }
+
+/*
+ * Population()
+ * @return The number of living cells.
+ */
+uint64_t Engine::HashLife::Population() const { return nodes[root].population; }
+
+/*
+ * NodeCount()
+ * @return The number of nodes in memory, including cached results.
+ */
+size_t Engine::HashLife::NodeCount() const { return nodes.size(); }
+
+/*
+ * Render()
+ * Draws part of the universe into a grid of pixels.
+ * @param left, top The cell at the top left of the view. Should be a multiple of 2^zoom when zoomed out.
+ * @param zoom Each pixel covers 2^zoom by 2^zoom cells, or each cell 2^-zoom by 2^-zoom pixels when negative.
+ * @param columns, rows The size of the view in pixels.
+ * @param coverage Set to how much of each pixel is alive, from 0 to 1, columns * rows of them.
+ */
+void Engine::HashLife::Render(const int64_t& left, const int64_t& top, const int& zoom, const int& columns, const int& rows, float* coverage) const
+{
+	memset(coverage, 0, sizeof(float) * columns * rows);
+
+	int64_t half = (int64_t)1 << (nodes[root].level - 1);
+	RenderNode(root, -half, -half, left, top, zoom, columns, rows, coverage);
+}
\ No newline at end of file
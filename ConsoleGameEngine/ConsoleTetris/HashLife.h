@@ -0,0 +1,98 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "LifeRule.h"
+
+namespace Engine
+{
+	/**
+	 * HashLife
+	 * A Life universe with no edges, stored as a quadtree where every distinct square of cells exists only once.
+	 * A node at level n is a 2^n by 2^n square made of four level n - 1 squares, down to single cells at level 0.
+	 * The result of running a node forward (the centre half of it, 2^j generations on) is cached on the node, so any pattern
+	 * that repeats in space or time is only ever worked out once, letting huge numbers of generations be skipped in one step.
+	 * Any B/S rule without B0 can be run. The smallest squares are looked up in a table built once per rule.
+	 */
+	class HashLife
+	{
+	private:
+		typedef uint32_t NodeID;
+
+		struct Node
+		{
+			NodeID nw, ne, sw, se;
+			NodeID result;
+			int8_t level;
+			int8_t resultStep;
+			uint64_t population;
+		};
+
+		struct NodeKey
+		{
+			NodeID nw, ne, sw, se;
+			bool operator==(const NodeKey& other) const { return nw == other.nw && ne == other.ne && sw == other.sw && se == other.se; }
+		};
+
+		struct NodeKeyHash
+		{
+			size_t operator()(const NodeKey& key) const;
+		};
+
+		std::vector<Node> nodes;
+		std::unordered_map<NodeKey, NodeID, NodeKeyHash> lookup;
+		std::vector<NodeID> emptyNodes;
+
+		LifeRule rule;
+		std::vector<unsigned char> baseResults;
+
+		NodeID root;
+		int stepLog2;
+		uint64_t generation;
+		size_t collectThreshold;
+
+		// Node Building
+		NodeID Join(const NodeID& nw, const NodeID& ne, const NodeID& sw, const NodeID& se);
+		NodeID Empty(const int& level);
+		NodeID Centre(const NodeID& node);
+		NodeID Expand(const NodeID& node);
+		NodeID SetCell(const NodeID& node, const int64_t& x, const int64_t& y, const bool& alive);
+
+		// Evolution
+		NodeID Successor(const NodeID& node, const int& step);
+		NodeID BaseSuccessor(const NodeID& node);
+		bool Contained(const NodeID& node) const;
+
+		// Memory
+		void Collect(void);
+		void Mark(const NodeID& node, std::vector<bool>& reachable, const bool& followResults) const;
+
+		// Queries
+		bool GetCell(const NodeID& node, int64_t x, int64_t y) const;
+		void RenderNode(const NodeID& node, const int64_t& x, const int64_t& y, const int64_t& left, const int64_t& top, const int& zoom, const int& columns, const int& rows, float* coverage) const;
+
+	public:
+		HashLife(const size_t& collectThreshold = 1 << 22);
+
+		void Clear(void);
+		bool SetRule(const LifeRule& rule);
+		const LifeRule& Rule(void) const;
+		bool Get(const int64_t& x, const int64_t& y) const;
+		void Set(const int64_t& x, const int64_t& y, const bool& alive);
+
+		void SetStepLog2(const int& stepLog2);
+		int StepLog2(void) const;
+		void Step(void);
+
+		uint64_t Generation(void) const;
+		uint64_t Population(void) const;
+		size_t NodeCount(void) const;
+
+		void Render(const int64_t& left, const int64_t& top, const int& zoom, const int& columns, const int& rows, float* coverage) const;
+
+		HashLife(HashLife const&) = delete;
+		void operator=(HashLife const&) = delete;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,188 @@
+#include <cstdio>
+#include <cstring>
+
+#include "Colour.h"
+#include "HeadlessRenderBackend.h"
+
+using namespace Engine::Graphics;
+
+// RGB values of the 16 console colours.
+static const unsigned char palette[16][3] = {
+	{   0,   0,   0 }, {   0,   0, 128 }, {   0, 128,   0 }, {   0, 128, 128 },
+	{ 128,   0,   0 }, { 128,   0, 128 }, { 128, 128,   0 }, { 192, 192, 192 },
+	{ 128, 128, 128 }, {   0,   0, 255 }, {   0, 255,   0 }, {   0, 255, 255 },
+	{ 255,   0,   0 }, { 255,   0, 255 }, { 255, 255,   0 }, { 255, 255, 255 }
+};
+
+/*
+ * OpenFile()
+ * Opens a file for writing on any platform.
+ * @param filename The filename of the file.
+ * @return The opened file, or nullptr if it could not be opened.
+ */
+static FILE* OpenFile(const std::string& filename)
+{
+	FILE* file = nullptr;
+#ifdef _WIN32
+	fopen_s(&file, filename.c_str(), "wb");
+#else
+	file = fopen(filename.c_str(), "wb");
+#endif
+	return file;
+}
+
+/**
+ * Constructor
+ * @param captureDirectory The directory frames are dumped to.
+ * @param captureFormat The format to dump frames in, None to keep them in memory only.
+ * @param captureInterval Dump every nth frame.
+ */
+HeadlessRenderBackend::HeadlessRenderBackend(const std::string& captureDirectory, const CaptureFormat& captureFormat, const int& captureInterval) : framebuffer(nullptr),
+	screenWidth(0), screenHeight(0), frameCount(0), captureDirectory(captureDirectory), captureFormat(captureFormat), captureInterval(captureInterval > 0 ? captureInterval : 1) { }
+
+/**
+ * Destructor
+ */
+HeadlessRenderBackend::~HeadlessRenderBackend()
+{
+	if (framebuffer != nullptr)
+		delete[] framebuffer;
+}
+
+const CharInfo* HeadlessRenderBackend::Framebuffer() const { return framebuffer; }
+int HeadlessRenderBackend::Width() const { return screenWidth; }
+int HeadlessRenderBackend::Height() const { return screenHeight; }
+int HeadlessRenderBackend::FrameCount() const { return frameCount; }
+
+/**
+ * SetupWindow()
+ * Resizes the framebuffer and clears it.
+ * @param width The width of the framebuffer in characters.
+ * @param height The height of the framebuffer in characters.
+ * @param fontWidth Unused.
+ * @param fontHeight Unused.
+ */
+void HeadlessRenderBackend::SetupWindow(const int& width, const int& height, const int& /*fontWidth*/, const int& /*fontHeight*/)
+{
+	screenWidth = width;
+	screenHeight = height;
+
+	if (framebuffer != nullptr)
+		delete[] framebuffer;
+
+	framebuffer = new CharInfo[screenWidth * screenHeight];
+	memset(framebuffer, 0, sizeof(CharInfo) * screenWidth * screenHeight);
+}
+
+/**
+ * Draw()
+ * Copies the changed spans into the framebuffer and dumps the frame if it is due for capture.
+ * @param title Unused.
+ * @param characterArray The array of characters that will be drawn.
+ * @param spans The changed spans of each dirty row, in row order.
+ * @param spanCount The number of spans given.
+ * @param stats Unused.
+ */
+void HeadlessRenderBackend::Draw(const wchar_t* /*title*/, const CharInfo* characterArray, const DirtySpan* spans, const int& spanCount, const FrameStats& /*stats*/)
+{
+	for (int i = 0; i < spanCount; ++i)
+	{
+		int start = (spans[i].row * screenWidth) + spans[i].minX;
+		memcpy(&framebuffer[start], &characterArray[start], sizeof(CharInfo) * (spans[i].maxX - spans[i].minX + 1));
+	}
+
+	if (captureFormat != CaptureFormat::None && frameCount % captureInterval == 0)
+	{
+		char filename[32];
+		snprintf(filename, 32, "frame_%06d.%s", frameCount, captureFormat == CaptureFormat::Binary ? "cgf" : "ppm");
+		SaveFrame(captureDirectory.empty() ? filename : captureDirectory + "/" + filename, captureFormat);
+	}
+
+	++frameCount;
+}
+
+/**
+ * SaveFrame()
+ * Dumps the current framebuffer to a file.
+ * @param filename The filename to save to.
+ * @param format The format to save in.
+ * @return False if the file could not be written.
+ */
+bool HeadlessRenderBackend::SaveFrame(const std::string& filename, const CaptureFormat& format) const
+{
+	switch (format)
+	{
+	case CaptureFormat::Binary: return SaveBinary(filename);
+	case CaptureFormat::PPM: return SavePPM(filename);
+	default: return false;
+	}
+}
+
+// CAPTURE FUNCTIONS #########################################################################################################################################
+
+/**
+ * SaveBinary()
+ * Saves the framebuffer as "CGEF", the width and height as ints, then the characters row by row.
+ * @param filename The filename to save to.
+ * @return False if the file could not be written.
+ */
+bool HeadlessRenderBackend::SaveBinary(const std::string& filename) const
+{
+	FILE* file = OpenFile(filename);
+	if (file == nullptr)
+		return false;
+
+	fwrite("CGEF", 1, 4, file);
+	fwrite(&screenWidth, sizeof(int), 1, file);
+	fwrite(&screenHeight, sizeof(int), 1, file);
+	fwrite(framebuffer, sizeof(CharInfo), screenWidth * screenHeight, file);
+
+	fclose(file);
+	return true;
+}
+
+/**
+ * SavePPM()
+ * Saves the framebuffer as a binary PPM image with one pixel per character.
+ * Each pixel blends the foreground and background colours by how much of the cell the character covers.
+ * @param filename The filename to save to.
+ * @return False if the file could not be written.
+ */
+bool HeadlessRenderBackend::SavePPM(const std::string& filename) const
+{
+	FILE* file = OpenFile(filename);
+	if (file == nullptr)
+		return false;
+
+	fprintf(file, "P6\n%d %d\n255\n", screenWidth, screenHeight);
+
+	unsigned char* row = new unsigned char[screenWidth * 3];
+	for (int y = 0; y < screenHeight; ++y)
+	{
+		for (int x = 0; x < screenWidth; ++x)
+		{
+			const CharInfo& cell = framebuffer[(y * screenWidth) + x];
+
+			int coverage;
+			switch (cell.Char.UnicodeChar)
+			{
+			case PIXEL_SOLID:        coverage = 4; break;
+			case PIXEL_THREEQUARTER: coverage = 3; break;
+			case PIXEL_HALF:         coverage = 2; break;
+			case PIXEL_QUARTER:      coverage = 1; break;
+			case 0: case ' ':        coverage = 0; break;
+			default:                 coverage = 2; // Text
+			}
+
+			const unsigned char* foreground = palette[cell.Attributes & 0x0F];
+			const unsigned char* background = palette[(cell.Attributes >> 4) & 0x0F];
+			for (int c = 0; c < 3; ++c)
+				row[(x * 3) + c] = (unsigned char)(((foreground[c] * coverage) + (background[c] * (4 - coverage))) / 4);
+		}
+		fwrite(row, 1, screenWidth * 3, file);
+	}
+	delete[] row;
+
+	fclose(file);
+	return true;
+}
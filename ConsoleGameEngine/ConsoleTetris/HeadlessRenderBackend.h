@@ -0,0 +1,54 @@
+#pragma once
+#include <string>
+
+#include "RenderBackend.h"
+
+namespace Engine { namespace Graphics {
+	/**
+	 * CaptureFormat
+	 * The file format frames are dumped in by the headless backend.
+	 *		- None: Frames are kept in memory only.
+	 *		- Binary: The raw characters and colours, for exact comparison against golden captures.
+	 *		- PPM: One pixel per character, coloured with the console palette, for viewing.
+	 */
+	enum class CaptureFormat
+	{
+		None = 0, Binary = 1, PPM = 2
+	};
+
+	/**
+	 * HeadlessRenderBackend
+	 * Draws the screen buffer to an in-memory framebuffer rather than a console, optionally dumping frames to files.
+	 * Used to run games without a console for benchmarks and regression tests.
+	 */
+	class HeadlessRenderBackend : public RenderBackend
+	{
+	private:
+		CharInfo* framebuffer;
+		int screenWidth;
+		int screenHeight;
+		int frameCount;
+
+		std::string captureDirectory;
+		CaptureFormat captureFormat;
+		int captureInterval;
+
+		// Capture Functions
+		bool SaveBinary(const std::string& filename) const;
+		bool SavePPM(const std::string& filename) const;
+
+	public:
+		HeadlessRenderBackend(const std::string& captureDirectory = "", const CaptureFormat& captureFormat = CaptureFormat::None, const int& captureInterval = 1);
+		~HeadlessRenderBackend(void);
+
+		const CharInfo* Framebuffer(void) const;
+		int Width(void) const;
+		int Height(void) const;
+		int FrameCount(void) const;
+
+		void SetupWindow(const int& width, const int& height, const int& fontWidth, const int& fontHeight) override;
+		void Draw(const wchar_t* title, const CharInfo* characterArray, const DirtySpan* spans, const int& spanCount, const FrameStats& stats) override;
+
+		bool SaveFrame(const std::string& filename, const CaptureFormat& format) const;
+	};
+} }
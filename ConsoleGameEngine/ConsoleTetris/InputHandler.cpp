@@ -1,13 +1,28 @@
 #include "InputHandler.h"
+#ifndef _WIN32
+#include <unistd.h>
+#endif
 
 /*
  * Constructor
  */
 InputHandler::InputHandler() : mousePosition(0.0f, 0.0f)
 {
+#ifdef _WIN32
 	consoleIn = GetStdHandle(STD_INPUT_HANDLE);
 	SetConsoleMode(consoleIn, ENABLE_EXTENDED_FLAGS | ENABLE_WINDOW_INPUT | ENABLE_MOUSE_INPUT);
+#else
+	// Raw stdin so key presses arrive without waiting for enter. VMIN and VTIME of 0 make reads return straight away,
+	// which leaves stdout (usually the same tty) blocking so frames are never cut short.
+	tcgetattr(STDIN_FILENO, &originalTerminal);
+	struct termios raw = originalTerminal;
+	raw.c_lflag &= ~(ICANON | ECHO);
+	raw.c_cc[VMIN] = 0;
+	raw.c_cc[VTIME] = 0;
+	tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+#endif
 
+	memset(currentMouseState, 0, sizeof(bool) * 5);
 	memset(keyboardState, 0, sizeof(ButtonState) * 256);
 	memset(previousKeyState, 0, sizeof(short) * 256);
 	memset(mouseButtonState, 0, sizeof(ButtonState) * 5);
@@ -17,7 +32,12 @@ InputHandler::InputHandler() : mousePosition(0.0f, 0.0f)
 /*
  * Destructor
  */
-InputHandler::~InputHandler() { }
+InputHandler::~InputHandler()
+{
+#ifndef _WIN32
+	tcsetattr(STDIN_FILENO, TCSANOW, &originalTerminal);
+#endif
+}
 
 /*
  * UpdateKeyState()
@@ -26,10 +46,19 @@ InputHandler::~InputHandler() { }
  */
 void InputHandler::UpdateKeyState()
 {
+#ifndef _WIN32
+	bool keysDown[256];
+	ReadTerminalKeys(keysDown);
+#endif
+
 	// Keyboard State
 	for (int i = 0; i < 256; ++i)
 	{
+#ifdef _WIN32
 		short state = GetAsyncKeyState(i);
+#else
+		short state = keysDown[i] ? 1 : 0;
+#endif
 		if (state == 0 && previousKeyState[i] != 0)
 			keyboardState[i] = ButtonState::Released;
 		else if (state != 0 && previousKeyState[i] == 0)
@@ -42,6 +71,7 @@ void InputHandler::UpdateKeyState()
 		previousKeyState[i] = state;
 	}
 
+#ifdef _WIN32
 	// Get Mouse Events
 	INPUT_RECORD inBuf[32];
 	DWORD events = 0;
@@ -68,6 +98,7 @@ void InputHandler::UpdateKeyState()
 			break;
 		}
 	}
+#endif
 
 	// Mouse State
 	for (int m = 0; m < 5; ++m)
@@ -85,6 +116,54 @@ void InputHandler::UpdateKeyState()
 	}
 }
 
+#ifndef _WIN32
+/*
+ * ReadTerminalKeys()
+ * Reads every key press waiting on stdin and works out which keys are currently down.
+ * Arrow and delete escape sequences are mapped to their virtual key codes and letters to upper case.
+ * @param keysDown Array of 256 keys, set to true for each key that is down.
+ */
+void InputHandler::ReadTerminalKeys(bool* keysDown)
+{
+	std::chrono::time_point<std::chrono::steady_clock> now = std::chrono::steady_clock::now();
+
+	unsigned char input[64];
+	int length;
+	while ((length = (int)read(STDIN_FILENO, input, sizeof(input))) > 0)
+	{
+		for (int i = 0; i < length; ++i)
+		{
+			int key = input[i];
+
+			if (key == 0x1B && i + 2 < length && input[i + 1] == '[')
+			{
+				// Escape sequence
+				switch (input[i + 2])
+				{
+				case 'A': key = VK_UP; break;
+				case 'B': key = VK_DOWN; break;
+				case 'C': key = VK_RIGHT; break;
+				case 'D': key = VK_LEFT; break;
+				case '3': key = VK_DELETE; ++i; break; // "\x1b[3~"
+				}
+				i += 2;
+			}
+			else if (key == '\n' || key == '\r')
+				key = VK_RETURN;
+			else if (key == 0x7F)
+				key = VK_DELETE;
+			else if (key >= 'a' && key <= 'z')
+				key -= 'a' - 'A';
+
+			lastKeyTime[key] = now;
+		}
+	}
+
+	for (int i = 0; i < 256; ++i)
+		keysDown[i] = std::chrono::duration<float>(now - lastKeyTime[i]).count() < keyHoldTime;
+}
+#endif
+
 /**
  * IsKeyPressed()
  * Gets whether a key has just been pressed.
@@ -1,5 +1,22 @@
 #pragma once
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#ifdef _WIN32
 #include <Windows.h>
+#else
+#include <termios.h>
+
+// Virtual key codes for the keys used by the games, matching their Windows values.
+#define VK_RETURN 0x0D
+#define VK_ESCAPE 0x1B
+#define VK_SPACE 0x20
+#define VK_LEFT 0x25
+#define VK_UP 0x26
+#define VK_RIGHT 0x27
+#define VK_DOWN 0x28
+#define VK_DELETE 0x2E
+#endif
 
 #include "FVector2.h"
 #include "Singleton.h"
@@ -20,7 +37,17 @@ class InputHandler : public Engine::Singleton<InputHandler>
 	friend class Engine::Singleton<InputHandler>;
 
 private:
+#ifdef _WIN32
 	HANDLE consoleIn;
+#else
+	// Terminals only report key presses (and auto-repeats), so a key counts as down until
+	// no press has been seen for keyHoldTime seconds.
+	const float keyHoldTime = 0.1f;
+	struct termios originalTerminal;
+	std::chrono::time_point<std::chrono::steady_clock> lastKeyTime[256];
+
+	void ReadTerminalKeys(bool* keysDown);
+#endif
 
 	ButtonState keyboardState[256];
 	short previousKeyState[256];
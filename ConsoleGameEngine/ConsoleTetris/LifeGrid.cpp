@@ -0,0 +1,535 @@
+#include <cstring>
+
+#include "LifeGrid.h"
+#include "ThreadPool.h"
+
+// The AVX2 kernel is built on any x86 compiler and only run if the CPU has AVX2, so one build works everywhere
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define LIFE_SIMD_AVX2
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// MSVC emits AVX2 instructions wherever their intrinsics are used, GCC and Clang only inside functions that ask for them
+#if defined(_MSC_VER)
+#define LIFE_INLINE __forceinline
+#define LIFE_TARGET_AVX2
+#else
+#define LIFE_INLINE inline __attribute__((always_inline))
+#define LIFE_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+// The size of a tile, in words across and rows down
+static const int TILE_WORDS = 4;
+static const int TILE_ROWS = 16;
+
+// CELL LOGIC ##################################################################################################################################################
+
+/*
+ * NextWord()
+ * Works out the next generation of 64 cells under Conway's rules (born with 3 neighbours, survives with 2 or 3).
+ * Each row's neighbours are summed across three columns into 2 bit counts, one bit per word, then the three rows' counts are added.
+ * Only whether the total is 2 or 3 matters: its lowest bit tells them apart, and the rest must add up to exactly one.
+ * @param aboveWest, above, aboveEast The row above, lined up so each cell's west, middle and east neighbours are at its bit.
+ * @param west, alive, east The cells' own row.
+ * @param belowWest, below, belowEast The row below.
+ * @return The cells in the next generation.
+ */
+template <typename Word>
+LIFE_INLINE static Word NextWord(const Word& aboveWest, const Word& above, const Word& aboveEast, const Word& west, const Word& alive, const Word& east,
+							const Word& belowWest, const Word& below, const Word& belowEast)
+{
+	// Above and below - three neighbours each, so counts of 0 to 3
+	Word aboveOnes = aboveWest ^ above ^ aboveEast;
+	Word aboveTwos = (aboveWest & above) | (aboveEast & (aboveWest ^ above));
+	Word belowOnes = belowWest ^ below ^ belowEast;
+	Word belowTwos = (belowWest & below) | (belowEast & (belowWest ^ below));
+
+	// Either side - two neighbours, so 0 to 2
+	Word middleOnes = west ^ east;
+	Word middleTwos = west & east;
+
+	// Add the ones, carrying into the twos
+	Word ones = aboveOnes ^ middleOnes ^ belowOnes;
+	Word carry = (aboveOnes & middleOnes) | (belowOnes & (aboveOnes ^ middleOnes));
+
+	// Exactly one of the four twos - more would make the total 4 or over
+	Word pairA = aboveTwos ^ middleTwos;
+	Word pairB = belowTwos ^ carry;
+	Word exactlyOneTwo = (pairA ^ pairB) & ~((aboveTwos & middleTwos) | (belowTwos & carry));
+
+	return exactlyOneTwo & (ones | alive);
+}
+
+/*
+ * NextWordRule()
+ * Works out the next generation of 64 cells under any B/S rule.
+ * The neighbours are added up in full, into four words that each hold one bit of every cell's count (bit slices),
+ * then compared against each count the rule uses, so the work depends on the rule rather than on the cells.
+ * @param aboveWest, above, aboveEast The row above, lined up so each cell's west, middle and east neighbours are at its bit.
+ * @param west, alive, east The cells' own row.
+ * @param belowWest, below, belowEast The row below.
+ * @param rule The rule to apply.
+ * @return The cells in the next generation.
+ */
+template <typename Word>
+LIFE_INLINE static Word NextWordRule(const Word& aboveWest, const Word& above, const Word& aboveEast, const Word& west, const Word& alive, const Word& east,
+								const Word& belowWest, const Word& below, const Word& belowEast, const Engine::LifeRule& rule)
+{
+	Word aboveOnes = aboveWest ^ above ^ aboveEast;
+	Word aboveTwos = (aboveWest & above) | (aboveEast & (aboveWest ^ above));
+	Word belowOnes = belowWest ^ below ^ belowEast;
+	Word belowTwos = (belowWest & below) | (belowEast & (belowWest ^ below));
+	Word middleOnes = west ^ east;
+	Word middleTwos = west & east;
+
+	Word ones = aboveOnes ^ middleOnes ^ belowOnes;
+	Word carry = (aboveOnes & middleOnes) | (belowOnes & (aboveOnes ^ middleOnes));
+
+	// Four twos add up to at most 8, so at most two of the carries into the fours can be set at once
+	Word pairA = aboveTwos ^ middleTwos;
+	Word pairB = belowTwos ^ carry;
+	Word twos = pairA ^ pairB;
+	Word carryA = aboveTwos & middleTwos, carryB = belowTwos & carry, carryC = pairA & pairB;
+	Word fours = carryA ^ carryB ^ carryC;
+	Word eights = carryA & carryB;
+
+	Word notOnes = ~ones, notTwos = ~twos, notFours = ~fours, notEights = ~eights, dead = ~alive;
+	Word result = alive ^ alive;
+	const Engine::LifeRule::Match* matches = rule.Matches();
+	for (int i = 0; i < rule.MatchCount(); ++i)
+	{
+		int count = matches[i].count;
+		Word match = ((count & 1) ? ones : notOnes) & ((count & 2) ? twos : notTwos) & ((count & 4) ? fours : notFours) & ((count & 8) ? eights : notEights);
+		if (!matches[i].dead)
+			match = match & alive;
+		else if (!matches[i].alive)
+			match = match & dead;
+		result = result | match;
+	}
+	return result;
+}
+
+/*
+ * StepWords()
+ * Works out the next generation of part of a row, a word at a time.
+ * @param above The row above.
+ * @param row The row.
+ * @param below The row below.
+ * @param out Set to the row in the next generation.
+ * @param first The first word to work out.
+ * @param words The number of words in a row.
+ * @param rule The rule to apply. Ignored when Conway is true, which uses the B3/S23 kernel.
+ */
+template <bool Conway>
+LIFE_INLINE static void StepWords(const uint64_t* above, const uint64_t* row, const uint64_t* below, uint64_t* out, const int& first, const int& words, const Engine::LifeRule& rule)
+{
+	for (int i = first; i < words; ++i)
+	{
+		// Column x - 1 is the bit below x, so shifting up lines each cell up with its west neighbour
+		uint64_t aboveWest = (above[i] << 1) | (above[i - 1] >> 63), aboveEast = (above[i] >> 1) | (above[i + 1] << 63);
+		uint64_t west = (row[i] << 1) | (row[i - 1] >> 63), east = (row[i] >> 1) | (row[i + 1] << 63);
+		uint64_t belowWest = (below[i] << 1) | (below[i - 1] >> 63), belowEast = (below[i] >> 1) | (below[i + 1] << 63);
+
+		out[i] = Conway ? NextWord(aboveWest, above[i], aboveEast, west, row[i], east, belowWest, below[i], belowEast)
+						: NextWordRule(aboveWest, above[i], aboveEast, west, row[i], east, belowWest, below[i], belowEast, rule);
+	}
+}
+
+/*
+ * StepRow()
+ * Works out the next generation of one row, a word at a time.
+ * @param above The row above.
+ * @param row The row.
+ * @param below The row below.
+ * @param out Set to the row in the next generation.
+ * @param words The number of words in a row.
+ * @param rule The rule to apply. Ignored when Conway is true, which uses the B3/S23 kernel.
+ */
+template <bool Conway>
+static void StepRow(const uint64_t* above, const uint64_t* row, const uint64_t* below, uint64_t* out, const int& words, const Engine::LifeRule& rule)
+{
+	StepWords<Conway>(above, row, below, out, 0, words, rule);
+}
+
+#if defined(LIFE_SIMD_AVX2)
+/*
+ * LifeLanes
+ * 4 words in one AVX2 register, with the operators NextWord() needs.
+ * GCC and Clang build these from the vector's own operators rather than intrinsics, so the kernels that use them
+ * don't need AVX2 switched on themselves and can be inlined into StepRowAvx2(), which does.
+ */
+struct LifeLanes
+{
+	__m256i value;
+};
+
+#if defined(_MSC_VER)
+LIFE_INLINE static LifeLanes operator^(const LifeLanes& a, const LifeLanes& b) { return { _mm256_xor_si256(a.value, b.value) }; }
+LIFE_INLINE static LifeLanes operator&(const LifeLanes& a, const LifeLanes& b) { return { _mm256_and_si256(a.value, b.value) }; }
+LIFE_INLINE static LifeLanes operator|(const LifeLanes& a, const LifeLanes& b) { return { _mm256_or_si256(a.value, b.value) }; }
+LIFE_INLINE static LifeLanes operator~(const LifeLanes& a) { return { _mm256_xor_si256(a.value, _mm256_set1_epi64x(-1)) }; }
+#else
+LIFE_INLINE static LifeLanes operator^(const LifeLanes& a, const LifeLanes& b) { return { a.value ^ b.value }; }
+LIFE_INLINE static LifeLanes operator&(const LifeLanes& a, const LifeLanes& b) { return { a.value & b.value }; }
+LIFE_INLINE static LifeLanes operator|(const LifeLanes& a, const LifeLanes& b) { return { a.value | b.value }; }
+LIFE_INLINE static LifeLanes operator~(const LifeLanes& a) { return { ~a.value }; }
+#endif
+
+/*
+ * CpuHasAvx2()
+ * Checked once, the first time a LifeGrid picks its kernel.
+ * @return True if the CPU has AVX2 and the OS saves the AVX registers.
+ */
+static bool CpuHasAvx2()
+{
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7)
+		return false;
+
+	// OSXSAVE and AVX, then the OS saving the SSE and AVX state
+	__cpuid(info, 1);
+	if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 || (_xgetbv(0) & 0x6) != 0x6)
+		return false;
+
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+/*
+ * StepRowAvx2()
+ * Works out the next generation of one row, 4 words at a time, then the words left over one at a time.
+ * Must only be called if CpuHasAvx2().
+ * @param above The row above.
+ * @param row The row.
+ * @param below The row below.
+ * @param out Set to the row in the next generation.
+ * @param words The number of words in a row.
+ * @param rule The rule to apply. Ignored when Conway is true, which uses the B3/S23 kernel.
+ */
+template <bool Conway>
+LIFE_TARGET_AVX2 static void StepRowAvx2(const uint64_t* above, const uint64_t* row, const uint64_t* below, uint64_t* out, const int& words, const Engine::LifeRule& rule)
+{
+	int i = 0;
+
+	// Reading a word either side is always safe thanks to the dead words around every row
+	for (; i + 4 <= words; i += 4)
+	{
+		LifeLanes lines[3][3];
+		const uint64_t* sources[3] = { above, row, below };
+		for (int r = 0; r < 3; ++r)
+		{
+			__m256i previous = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sources[r] + i - 1));
+			__m256i middle = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sources[r] + i));
+			__m256i following = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sources[r] + i + 1));
+			lines[r][0].value = _mm256_or_si256(_mm256_slli_epi64(middle, 1), _mm256_srli_epi64(previous, 63));
+			lines[r][1].value = middle;
+			lines[r][2].value = _mm256_or_si256(_mm256_srli_epi64(middle, 1), _mm256_slli_epi64(following, 63));
+		}
+
+		LifeLanes result = Conway ? NextWord(lines[0][0], lines[0][1], lines[0][2], lines[1][0], lines[1][1], lines[1][2], lines[2][0], lines[2][1], lines[2][2])
+								  : NextWordRule(lines[0][0], lines[0][1], lines[0][2], lines[1][0], lines[1][1], lines[1][2], lines[2][0], lines[2][1], lines[2][2], rule);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), result.value);
+	}
+
+	StepWords<Conway>(above, row, below, out, i, words, rule);
+}
+#endif
+
+// GRID ########################################################################################################################################################
+
+/**
+ * Constructor
+ * @param width The number of columns on the board.
+ * @param height The number of rows on the board.
+ */
+Engine::LifeGrid::LifeGrid(const int& width, const int& height) : width(width), height(height)
+{
+	words = (width + 63) / 64;
+	stride = words + 2;
+	lastWordMask = (width % 64 == 0) ? ~0ULL : (1ULL << (width % 64)) - 1;
+
+	size_t boardWords = (size_t)stride * (size_t)(height + 2);
+	current = new uint64_t[boardWords];
+	next = new uint64_t[boardWords];
+	memset(current, 0, sizeof(uint64_t) * boardWords);
+	memset(next, 0, sizeof(uint64_t) * boardWords);
+
+	tilesAcross = (words + TILE_WORDS - 1) / TILE_WORDS;
+	tilesDown = (height + TILE_ROWS - 1) / TILE_ROWS;
+	tileChanged = new unsigned char[tilesAcross * tilesDown];
+	tileActive = new unsigned char[tilesAcross * tilesDown];
+	memset(tileChanged, 0, tilesAcross * tilesDown);
+	memset(tileActive, 0, tilesAcross * tilesDown);
+
+	// Sized for the worst case up front so stepping never allocates
+	changedTiles.reserve(tilesAcross * tilesDown);
+	activeTiles.reserve(tilesAcross * tilesDown);
+	activeChanged.reserve(tilesAcross * tilesDown);
+
+	ChooseKernel();
+}
+
+/**
+ * Destructor
+ */
+Engine::LifeGrid::~LifeGrid()
+{
+	delete[] current;
+	delete[] next;
+	delete[] tileChanged;
+	delete[] tileActive;
+}
+
+/*
+ * RowOf()
+ * @param board Either of the boards.
+ * @param y The row, from -1 for the dead row above the board to height for the one below it.
+ * @return The first word of the row, with a dead word before it and after its last.
+ */
+uint64_t* Engine::LifeGrid::RowOf(uint64_t* board, const int& y) const { return board + ((size_t)(y + 1) * (size_t)stride) + 1; }
+
+/*
+ * ChooseKernel()
+ * Picks the row kernel for the rule, using AVX2 if the CPU has it, so Step() doesn't have to decide for every row.
+ */
+void Engine::LifeGrid::ChooseKernel()
+{
+	bool conway = rule.IsConway();
+	stepRow = conway ? &StepRow<true> : &StepRow<false>;
+
+#if defined(LIFE_SIMD_AVX2)
+	static const bool avx2 = CpuHasAvx2();
+	if (avx2)
+		stepRow = conway ? &StepRowAvx2<true> : &StepRowAvx2<false>;
+#endif
+}
+
+/*
+ * MarkChanged()
+ * Flags a tile as changed, so it and its neighbours are worked out next Step().
+ * @param tile The tile.
+ */
+void Engine::LifeGrid::MarkChanged(const int& tile)
+{
+	if (tileChanged[tile])
+		return;
+	tileChanged[tile] = 1;
+	changedTiles.push_back(tile);
+}
+
+/*
+ * StepTile()
+ * Works out the next generation of one tile into the next board. Only the tile's own words are written, so tiles can be stepped in parallel.
+ * @param tile The tile.
+ * @return True if any of the tile's cells changed.
+ */
+bool Engine::LifeGrid::StepTile(const int& tile)
+{
+	int firstWord = (tile % tilesAcross) * TILE_WORDS;
+	int wordCount = (firstWord + TILE_WORDS <= words) ? TILE_WORDS : words - firstWord;
+	int firstRow = (tile / tilesAcross) * TILE_ROWS;
+	int lastRow = (firstRow + TILE_ROWS <= height) ? firstRow + TILE_ROWS : height;
+	bool lastColumn = firstWord + wordCount == words;
+
+	uint64_t difference = 0;
+	for (int y = firstRow; y < lastRow; ++y)
+	{
+		const uint64_t* row = RowOf(current, y) + firstWord;
+		uint64_t* out = RowOf(next, y) + firstWord;
+		stepRow(row - stride, row, row + stride, out, wordCount, rule);
+
+		// Cells past the last column must stay dead, or they would count as neighbours
+		if (lastColumn)
+			out[wordCount - 1] &= lastWordMask;
+
+		for (int i = 0; i < wordCount; ++i)
+			difference |= out[i] ^ row[i];
+	}
+	return difference != 0;
+}
+
+/*
+ * Width()
+ * @return The number of columns on the board.
+ */
+int Engine::LifeGrid::Width() const { return width; }
+
+/*
+ * Height()
+ * @return The number of rows on the board.
+ */
+int Engine::LifeGrid::Height() const { return height; }
+
+/*
+ * WordsPerRow()
+ * @return The number of words each row is packed into.
+ */
+int Engine::LifeGrid::WordsPerRow() const { return words; }
+
+/*
+ * Get()
+ * @param x The column of the cell.
+ * @param y The row of the cell.
+ * @return True if the cell is alive. Cells off the board are always dead.
+ */
+bool Engine::LifeGrid::Get(const int& x, const int& y) const
+{
+	if (x < 0 || x >= width || y < 0 || y >= height)
+		return false;
+	return ((RowOf(current, y)[x / 64] >> (x % 64)) & 1) != 0;
+}
+
+/*
+ * Set()
+ * Brings a cell to life or kills it. Cells off the board are ignored.
+ * @param x The column of the cell.
+ * @param y The row of the cell.
+ * @param alive Whether the cell should be alive.
+ */
+void Engine::LifeGrid::Set(const int& x, const int& y, const bool& alive)
+{
+	if (x < 0 || x >= width || y < 0 || y >= height)
+		return;
+
+	uint64_t& word = RowOf(current, y)[x / 64];
+	word = alive ? word | (1ULL << (x % 64)) : word & ~(1ULL << (x % 64));
+	MarkChanged(((y / TILE_ROWS) * tilesAcross) + (x / 64 / TILE_WORDS));
+}
+
+/*
+ * Clear()
+ * Kills every cell.
+ */
+void Engine::LifeGrid::Clear()
+{
+	memset(current, 0, sizeof(uint64_t) * (size_t)stride * (size_t)(height + 2));
+	memset(next, 0, sizeof(uint64_t) * (size_t)stride * (size_t)(height + 2));
+
+	for (size_t i = 0; i < changedTiles.size(); ++i)
+		tileChanged[changedTiles[i]] = 0;
+	changedTiles.clear();
+}
+
+/*
+ * Population()
+ * @return The number of living cells.
+ */
+size_t Engine::LifeGrid::Population() const
+{
+	size_t count = 0;
+	for (int y = 0; y < height; ++y)
+	{
+		const uint64_t* row = RowOf(current, y);
+		for (int i = 0; i < words; ++i)
+			for (uint64_t word = row[i]; word != 0; word &= word - 1)
+				++count;
+	}
+	return count;
+}
+
+/*
+ * Row()
+ * @param y The row.
+ * @return The row's cells, WordsPerRow() words of them. Bits past the last column are always 0.
+ */
+const uint64_t* Engine::LifeGrid::Row(const int& y) const { return RowOf(current, y); }
+
+/*
+ * SetRule()
+ * Changes the rule the board runs under. Every tile is worked out on the next Step(), since settled areas may not be settled under the new rule.
+ * Cells off the board still count as dead, so rules with B0 only behave away from the edges.
+ * @param rule The new rule.
+ */
+void Engine::LifeGrid::SetRule(const LifeRule& rule)
+{
+	this->rule = rule;
+	ChooseKernel();
+	for (int tile = 0; tile < tilesAcross * tilesDown; ++tile)
+		MarkChanged(tile);
+}
+
+/*
+ * Rule()
+ * @return The rule the board runs under.
+ */
+const Engine::LifeRule& Engine::LifeGrid::Rule() const { return rule; }
+
+/*
+ * Step()
+ * Advances the board one generation, only working out the tiles that changed last generation and their neighbours.
+ * The rest are already the same in both boards, since they didn't change, so swapping the boards leaves them right.
+ * @param pool The threads to share the tiles between, or nullptr to step them all on this thread.
+ */
+void Engine::LifeGrid::Step(ThreadPool* pool)
+{
+	// Every tile touching a changed one could change this generation
+	activeTiles.clear();
+	for (size_t i = 0; i < changedTiles.size(); ++i)
+	{
+		int tileX = changedTiles[i] % tilesAcross, tileY = changedTiles[i] / tilesAcross;
+		for (int y = tileY - 1; y <= tileY + 1; ++y)
+		{
+			for (int x = tileX - 1; x <= tileX + 1; ++x)
+			{
+				int tile = (y * tilesAcross) + x;
+				if (x < 0 || x >= tilesAcross || y < 0 || y >= tilesDown || tileActive[tile])
+					continue;
+				tileActive[tile] = 1;
+				activeTiles.push_back(tile);
+			}
+		}
+	}
+
+	activeChanged.resize(activeTiles.size());
+	auto stepTile = [this](int index) { activeChanged[index] = StepTile(activeTiles[index]) ? 1 : 0; };
+	if (pool != nullptr && activeTiles.size() > 1)
+		pool->ParallelFor((int)activeTiles.size(), stepTile);
+	else
+	{
+		for (int i = 0; i < (int)activeTiles.size(); ++i)
+			stepTile(i);
+	}
+
+	for (size_t i = 0; i < changedTiles.size(); ++i)
+		tileChanged[changedTiles[i]] = 0;
+	changedTiles.clear();
+	for (size_t i = 0; i < activeTiles.size(); ++i)
+	{
+		tileActive[activeTiles[i]] = 0;
+		if (activeChanged[i])
+			MarkChanged(activeTiles[i]);
+	}
+
+	uint64_t* swap = current;
+	current = next;
+	next = swap;
+}
+
+/*
+ * ChangedTiles()
+ * @return The tiles whose cells changed in the last Step() or have been Set() since.
+ */
+const std::vector<int>& Engine::LifeGrid::ChangedTiles() const { return changedTiles; }
+
+/*
+ * TileBounds()
+ * @param tile The tile.
+ * @param minX, minY Set to the tile's top left cell.
+ * @param maxX, maxY Set to one past the tile's bottom right cell, clamped to the board.
+ */
+void Engine::LifeGrid::TileBounds(const int& tile, int& minX, int& minY, int& maxX, int& maxY) const
+{
+	minX = (tile % tilesAcross) * TILE_WORDS * 64;
+	minY = (tile / tilesAcross) * TILE_ROWS;
+	maxX = (minX + (TILE_WORDS * 64) < width) ? minX + (TILE_WORDS * 64) : width;
+	maxY = (minY + TILE_ROWS < height) ? minY + TILE_ROWS : height;
+}
\ No newline at end of file
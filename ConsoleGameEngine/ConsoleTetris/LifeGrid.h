@@ -0,0 +1,77 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "LifeRule.h"
+
+namespace Engine
+{
+	class ThreadPool;
+
+	/**
+	 * LifeGrid
+	 * A Life board packed 64 cells to a word, bit x % 64 of word x / 64 holding column x of a row.
+	 * Each row has a dead word either side of it and the board a dead row above and below, so every cell's neighbours can be
+	 * read without checking the edges, and cells past the edge of the board are always dead.
+	 * A generation is worked out for 64 cells at once by adding up their neighbours with bitwise operations (an adder tree),
+	 * 4 words at a time with AVX2 if the CPU has it, into a second board that is then swapped with the first.
+	 * Any B/S rule can be run, with B3/S23 getting a shorter adder tree of its own.
+	 * The board is split into tiles, and only tiles that changed last generation, or sit next to one that did, are worked out again.
+	 * Every other tile is already the same in both boards, so settled areas cost nothing.
+	 */
+	class LifeGrid
+	{
+	private:
+		int width;
+		int height;
+		int words;
+		int stride;
+		uint64_t lastWordMask;
+		LifeRule rule;
+
+		// The row kernel for the rule and the CPU, picked by ChooseKernel()
+		void (*stepRow)(const uint64_t* above, const uint64_t* row, const uint64_t* below, uint64_t* out, const int& words, const LifeRule& rule);
+
+		uint64_t* current;
+		uint64_t* next;
+
+		// Tiles
+		int tilesAcross;
+		int tilesDown;
+		unsigned char* tileChanged;
+		unsigned char* tileActive;
+		std::vector<int> changedTiles;
+		std::vector<int> activeTiles;
+		std::vector<unsigned char> activeChanged;
+
+		uint64_t* RowOf(uint64_t* board, const int& y) const;
+		void ChooseKernel(void);
+		void MarkChanged(const int& tile);
+		bool StepTile(const int& tile);
+
+	public:
+		LifeGrid(const int& width, const int& height);
+		~LifeGrid(void);
+
+		int Width(void) const;
+		int Height(void) const;
+		int WordsPerRow(void) const;
+
+		bool Get(const int& x, const int& y) const;
+		void Set(const int& x, const int& y, const bool& alive);
+		void Clear(void);
+		size_t Population(void) const;
+		const uint64_t* Row(const int& y) const;
+
+		void SetRule(const LifeRule& rule);
+		const LifeRule& Rule(void) const;
+		void Step(ThreadPool* pool = nullptr);
+
+		const std::vector<int>& ChangedTiles(void) const;
+		void TileBounds(const int& tile, int& minX, int& minY, int& maxX, int& maxY) const;
+
+		LifeGrid(LifeGrid const&) = delete;
+		void operator=(LifeGrid const&) = delete;
+	};
+}
\ No newline at end of file
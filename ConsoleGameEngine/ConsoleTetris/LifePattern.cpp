@@ -0,0 +1,233 @@
+#include <cctype>
+#include <cstdlib>
+
+#include "LifePattern.h"
+#include "MappedFile.h"
+
+// The longest run an RLE file can ask for, so a broken file can't fill memory
+static const int MAX_RUN = 1 << 24;
+// The widest and tallest an RLE pattern can be, and the most living cells it can have, for the same reason
+static const int MAX_SIZE = 1 << 24;
+static const size_t MAX_CELLS = 1 << 24;
+
+/**
+ * Constructor
+ */
+Engine::LifePattern::LifePattern() : width(0), height(0), hasRule(false) { }
+
+/*
+ * LoadFromFile()
+ * Reads a pattern from a .rle or plaintext .cells file.
+ * @param filename The path to the file.
+ * @return True if the pattern was read, false if the file couldn't be opened or isn't a pattern.
+ */
+bool Engine::LifePattern::LoadFromFile(const std::string& filename)
+{
+	MappedFile file;
+	return file.Open(filename) && Parse(file.Data(), file.Size());
+}
+
+/*
+ * Parse()
+ * Reads a pattern from text, working out whether it's RLE or plaintext from the first line that isn't a comment.
+ * @param text The pattern's text, which doesn't need to be null terminated.
+ * @param length The length of the text.
+ * @return True if the pattern was read.
+ */
+bool Engine::LifePattern::Parse(const char* text, const size_t& length)
+{
+	cellX.clear();
+	cellY.clear();
+	width = 0;
+	height = 0;
+	rule = LifeRule();
+	hasRule = false;
+
+	// RLE files start with an "x = " header once the # comments are skipped
+	size_t i = 0;
+	while (i < length)
+	{
+		while (i < length && (text[i] == ' ' || text[i] == '\t' || text[i] == '\r' || text[i] == '\n'))
+			++i;
+		if (i < length && (text[i] == '#' || text[i] == '!'))
+		{
+			while (i < length && text[i] != '\n')
+				++i;
+			continue;
+		}
+		break;
+	}
+	if (i >= length)
+		return false;
+
+	size_t next = i + 1;
+	while (next < length && (text[next] == ' ' || text[next] == '\t'))
+		++next;
+	if (text[i] == 'x' && next < length && text[next] == '=')
+		return ParseRle(text, length);
+	return ParsePlaintext(text, length);
+}
+
+/*
+ * ParseRle()
+ * Reads a run length encoded pattern: an "x = width, y = height, rule = B3/S23" header, then runs of b (dead) and o (alive) cells
+ * with $ ending each row and ! ending the pattern. Any other letter counts as alive, so multi-state patterns load as their living cells.
+ * @param text The pattern's text.
+ * @param length The length of the text.
+ * @return True if the pattern was read.
+ */
+bool Engine::LifePattern::ParseRle(const char* text, const size_t& length)
+{
+	size_t i = 0;
+	bool readHeader = false;
+	int x = 0, y = 0, run = 0;
+
+	while (i < length)
+	{
+		// Comment and header lines
+		if ((x == 0 && run == 0) && (text[i] == '#' || (!readHeader && text[i] == 'x')))
+		{
+			size_t lineEnd = i;
+			while (lineEnd < length && text[lineEnd] != '\n')
+				++lineEnd;
+
+			if (text[i] == 'x')
+			{
+				readHeader = true;
+				std::string header(text + i, lineEnd - i);
+				size_t start = 0;
+				while (start < header.size())
+				{
+					size_t end = header.find(',', start);
+					if (end == std::string::npos)
+						end = header.size();
+
+					std::string field = header.substr(start, end - start);
+					size_t equals = field.find('=');
+					if (equals != std::string::npos)
+					{
+						std::string key, value = field.substr(equals + 1);
+						for (size_t k = 0; k < equals; ++k)
+							if (!isspace((unsigned char)field[k]))
+								key += (char)tolower((unsigned char)field[k]);
+
+						if (key == "x")
+							width = atoi(value.c_str());
+						else if (key == "y")
+							height = atoi(value.c_str());
+						if (width < 0 || width > MAX_SIZE || height < 0 || height > MAX_SIZE)
+							return false;
+						else if (key == "rule")
+							hasRule = rule.Parse(value.substr(0, value.find(':'))); // Any :T bounded grid suffix is ignored
+					}
+					start = end + 1;
+				}
+			}
+
+			i = lineEnd;
+			continue;
+		}
+
+		char c = text[i++];
+		if (c >= '0' && c <= '9')
+		{
+			run = (run * 10) + (c - '0');
+			if (run > MAX_RUN)
+				return false;
+			continue;
+		}
+		if (isspace((unsigned char)c))
+			continue;
+		if (c == '!')
+			break;
+
+		int count = (run > 0) ? run : 1;
+		run = 0;
+		if (c == '$')
+		{
+			// Runs are capped, so these sums can't overflow before they are checked
+			if (y + count > MAX_SIZE)
+				return false;
+			y += count;
+			x = 0;
+		}
+		else if (c == 'b' || c == '.')
+		{
+			if (x + count > MAX_SIZE)
+				return false;
+			x += count;
+		}
+		else if (isalpha((unsigned char)c))
+		{
+			if (x + count > MAX_SIZE || y >= MAX_SIZE || cellX.size() + (size_t)count > MAX_CELLS)
+				return false;
+			for (int k = 0; k < count; ++k)
+			{
+				cellX.push_back(x + k);
+				cellY.push_back(y);
+			}
+			x += count;
+			width = (x > width) ? x : width;
+			height = (y + 1 > height) ? y + 1 : height;
+		}
+		else
+			return false;
+	}
+
+	return readHeader;
+}
+
+/*
+ * ParsePlaintext()
+ * Reads a plaintext pattern: one line per row, with O (or *) for living cells and . for dead ones. Lines starting with ! are comments.
+ * @param text The pattern's text.
+ * @param length The length of the text.
+ * @return True if the pattern was read.
+ */
+bool Engine::LifePattern::ParsePlaintext(const char* text, const size_t& length)
+{
+	size_t i = 0;
+	int y = 0;
+
+	while (i < length)
+	{
+		size_t lineEnd = i;
+		while (lineEnd < length && text[lineEnd] != '\n')
+			++lineEnd;
+
+		if (text[i] != '!')
+		{
+			int x = 0;
+			for (size_t k = i; k < lineEnd; ++k)
+			{
+				char c = text[k];
+				if (c == 'O' || c == 'o' || c == '*')
+				{
+					cellX.push_back(x);
+					cellY.push_back(y);
+				}
+				else if (c != '.' && !isspace((unsigned char)c))
+					return false;
+
+				if (!isspace((unsigned char)c))
+					++x;
+			}
+			width = (x > width) ? x : width;
+			++y;
+		}
+
+		i = lineEnd + 1;
+	}
+
+	// Trailing blank lines aren't part of the pattern
+	height = 0;
+	for (size_t k = 0; k < cellY.size(); ++k)
+		height = (cellY[k] + 1 > height) ? cellY[k] + 1 : height;
+	return true;
+}
+
+/*
+ * CellCount()
+ * @return The number of living cells in the pattern.
+ */
+size_t Engine::LifePattern::CellCount() const { return cellX.size(); }
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "LifeRule.h"
+
+namespace Engine
+{
+	/**
+	 * LifePattern
+	 * A Life pattern read from a run length encoded (.rle) or plaintext (.cells) file, stored as the positions of its living cells
+	 * from the pattern's top left corner. The format is worked out from the text, not the file's extension.
+	 */
+	class LifePattern
+	{
+	private:
+		bool ParseRle(const char* text, const size_t& length);
+		bool ParsePlaintext(const char* text, const size_t& length);
+
+	public:
+		std::vector<int> cellX;
+		std::vector<int> cellY;
+		int width;
+		int height;
+
+		// The rule from the RLE header, if it gave one
+		LifeRule rule;
+		bool hasRule;
+
+		LifePattern(void);
+
+		bool LoadFromFile(const std::string& filename);
+		bool Parse(const char* text, const size_t& length);
+
+		size_t CellCount(void) const;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,157 @@
+#include <cctype>
+
+#include "LifeRule.h"
+
+// Conway's Game of Life, B3/S23
+static const unsigned short CONWAY_BIRTH = 1 << 3;
+static const unsigned short CONWAY_SURVIVAL = (1 << 2) | (1 << 3);
+
+/**
+ * Constructor
+ * Starts as Conway's Game of Life, B3/S23.
+ */
+Engine::LifeRule::LifeRule() : birth(CONWAY_BIRTH), survival(CONWAY_SURVIVAL)
+{
+	Compile();
+}
+
+/**
+ * Constructor
+ * @param birth Bit n set if n neighbours bring a dead cell to life.
+ * @param survival Bit n set if n neighbours keep a living cell alive.
+ */
+Engine::LifeRule::LifeRule(const unsigned short& birth, const unsigned short& survival) : birth(birth & 0x1FF), survival(survival & 0x1FF)
+{
+	Compile();
+}
+
+/*
+ * Compile()
+ * Builds the list of neighbour counts that give a living cell.
+ */
+void Engine::LifeRule::Compile()
+{
+	matchCount = 0;
+	for (int count = 0; count <= 8; ++count)
+	{
+		bool born = ((birth >> count) & 1) != 0, survives = ((survival >> count) & 1) != 0;
+		if (!born && !survives)
+			continue;
+
+		matches[matchCount].count = count;
+		matches[matchCount].dead = born;
+		matches[matchCount].alive = survives;
+		++matchCount;
+	}
+}
+
+/*
+ * Parse()
+ * Reads a rule string, either "B3/S23" or the older "23/3" survival/birth form. Letters may be either case.
+ * @param rule The rule string.
+ * @return True if the rule was read, false if it isn't a rule, in which case the rule is left as it was.
+ */
+bool Engine::LifeRule::Parse(const std::string& rule)
+{
+	unsigned short newBirth = 0, newSurvival = 0;
+	unsigned short* target = nullptr;
+	bool sawBirth = false, sawSurvival = false, slashForm = true;
+
+	for (size_t i = 0; i < rule.size(); ++i)
+	{
+		char c = (char)toupper((unsigned char)rule[i]);
+		if (c == 'B' && !sawBirth)
+		{
+			target = &newBirth;
+			sawBirth = true;
+			slashForm = false;
+		}
+		else if (c == 'S' && !sawSurvival)
+		{
+			target = &newSurvival;
+			sawSurvival = true;
+			slashForm = false;
+		}
+		else if (c >= '0' && c <= '8')
+		{
+			// Without letters the digits before the slash are survival
+			if (target == nullptr && slashForm)
+			{
+				target = &newSurvival;
+				sawSurvival = true;
+			}
+			if (target == nullptr)
+				return false;
+			*target |= (unsigned short)(1 << (c - '0'));
+		}
+		else if (c == '/')
+		{
+			if (slashForm)
+			{
+				if (sawBirth)
+					return false;
+				target = &newBirth;
+				sawBirth = true;
+			}
+			else
+				target = nullptr;
+		}
+		else if (!isspace((unsigned char)c))
+			return false;
+	}
+
+	if (!sawBirth && !sawSurvival)
+		return false;
+
+	birth = newBirth;
+	survival = newSurvival;
+	Compile();
+	return true;
+}
+
+/*
+ * ToString()
+ * @return The rule as a "B3/S23" string.
+ */
+std::string Engine::LifeRule::ToString() const
+{
+	std::string rule = "B";
+	for (int count = 0; count <= 8; ++count)
+		if ((birth >> count) & 1)
+			rule += (char)('0' + count);
+	rule += "/S";
+	for (int count = 0; count <= 8; ++count)
+		if ((survival >> count) & 1)
+			rule += (char)('0' + count);
+	return rule;
+}
+
+/*
+ * BirthMask()
+ * @return Bit n set if n neighbours bring a dead cell to life.
+ */
+unsigned short Engine::LifeRule::BirthMask() const { return birth; }
+
+/*
+ * SurvivalMask()
+ * @return Bit n set if n neighbours keep a living cell alive.
+ */
+unsigned short Engine::LifeRule::SurvivalMask() const { return survival; }
+
+/*
+ * IsConway()
+ * @return True if this is B3/S23, which has its own faster kernel.
+ */
+bool Engine::LifeRule::IsConway() const { return birth == CONWAY_BIRTH && survival == CONWAY_SURVIVAL; }
+
+/*
+ * Matches()
+ * @return The neighbour counts that give a living cell, MatchCount() of them, lowest first.
+ */
+const Engine::LifeRule::Match* Engine::LifeRule::Matches() const { return matches; }
+
+/*
+ * MatchCount()
+ * @return The number of neighbour counts that give a living cell.
+ */
+int Engine::LifeRule::MatchCount() const { return matchCount; }
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+#include <string>
+
+namespace Engine
+{
+	/**
+	 * LifeRule
+	 * An outer-totalistic Life-like rule, such as B3/S23: which neighbour counts bring a dead cell to life and which keep a living one alive.
+	 * The rule is compiled once, when it's set, into the list of counts that give a living cell and which cells they apply to,
+	 * so the kernels only test the counts the rule actually uses.
+	 */
+	class LifeRule
+	{
+	public:
+		/**
+		 * Match
+		 * A neighbour count that gives a living cell next generation.
+		 */
+		struct Match
+		{
+			int count;
+			bool dead;	// Brings dead cells to life
+			bool alive;	// Keeps living cells alive
+		};
+
+	private:
+		unsigned short birth;
+		unsigned short survival;
+
+		Match matches[9];
+		int matchCount;
+
+		void Compile(void);
+
+	public:
+		LifeRule(void);
+		LifeRule(const unsigned short& birth, const unsigned short& survival);
+
+		bool Parse(const std::string& rule);
+		std::string ToString(void) const;
+
+		unsigned short BirthMask(void) const;
+		unsigned short SurvivalMask(void) const;
+		bool IsConway(void) const;
+
+		const Match* Matches(void) const;
+		int MatchCount(void) const;
+	};
+}
\ No newline at end of file
@@ -1,8 +1,57 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
 #include "ArcadeGames.h"
+#include "Benchmark.h"
+#include "HeadlessRenderBackend.h"
 #include "SpriteEditor.h"
 
-int main()
+/*
+ * RunHeadless()
+ * Runs one of the arcade games without a console for a set number of frames and prints how fast it ran.
+ * Usage: --headless <appID> <frames> [captureDirectory] [binary|ppm] [captureInterval]
+ * @return The exit code of the program.
+ */
+static int RunHeadless(int argc, char* argv[])
 {
+	if (argc < 4)
+	{
+		printf("Usage: %s --headless <appID> <frames> [captureDirectory] [binary|ppm] [captureInterval]\n", argv[0]);
+		return 1;
+	}
+
+	int appID = atoi(argv[2]);
+	int frames = atoi(argv[3]);
+	std::string captureDirectory = (argc > 4) ? argv[4] : "";
+	CaptureFormat format = CaptureFormat::None;
+	if (argc > 4)
+		format = (argc > 5 && strcmp(argv[5], "ppm") == 0) ? CaptureFormat::PPM : CaptureFormat::Binary;
+	int captureInterval = (argc > 6) ? atoi(argv[6]) : 1;
+
+	// The backend must be in place before the engine sets up its window
+	RenderEngine::Instance().SetBackend(new HeadlessRenderBackend(captureDirectory, format, captureInterval));
+
+	ArcadeGames* game = new ArcadeGames(L"Arcade Games", 80, 30, 8, 16, appID);
+
+	std::chrono::time_point<std::chrono::steady_clock> start = std::chrono::steady_clock::now();
+	game->RunHeadless(frames);
+	std::chrono::duration<float> elapsed = std::chrono::steady_clock::now() - start;
+
+	printf("App %d: %d frames in %.3fs (%.1f frames/s, %d allocations in the last frame)\n", appID, game->FrameCount(), elapsed.count(), game->FrameCount() / elapsed.count(), game->FrameAllocations());
+
+	delete game;
+	return 0;
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc > 1 && strcmp(argv[1], "--headless") == 0)
+		return RunHeadless(argc, argv);
+	if (argc > 1 && strcmp(argv[1], "--bench") == 0)
+		return Benchmark::Run(argc, argv);
+
 	if (true) 
 	{
 		ArcadeGames* game = new ArcadeGames();
@@ -17,4 +66,4 @@ int main()
 	}
 
 	return 0;
-}
\ No newline at end of file
+}
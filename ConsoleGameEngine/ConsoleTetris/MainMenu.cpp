@@ -1,3 +1,5 @@
+#include <cwchar>
+
 #include "MainMenu.h"
 
 /*
@@ -84,8 +86,11 @@ void MainMenu::Draw()
 	// Draw Arrow Cursor
 	engine->DrawChar(4, currentOption + 2, '>');
 
-	engine->DrawString(2, 20, L"Mouse X: " + std::to_wstring(InputHandler::Instance().GetMousePosition().x));
-	engine->DrawString(2, 21, L"Mouse Y: " + std::to_wstring(InputHandler::Instance().GetMousePosition().y));
+	wchar_t text[64];
+	swprintf(text, 64, L"Mouse X: %f", InputHandler::Instance().GetMousePosition().x);
+	engine->DrawString(2, 20, text);
+	swprintf(text, 64, L"Mouse Y: %f", InputHandler::Instance().GetMousePosition().y);
+	engine->DrawString(2, 21, text);
 
 	if (InputHandler::Instance().IsMouseButtonHeld(0))
 		engine->DrawString(2, 22, L"Left Mouse Button: True");
@@ -0,0 +1,141 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Handed out for empty files, which can't be mapped
+static const char EMPTY_FILE[1] = { 0 };
+
+/**
+ * Constructor
+ */
+Engine::MappedFile::MappedFile() : data(nullptr), size(0)
+#ifdef _WIN32
+	, file(INVALID_HANDLE_VALUE), mapping(NULL)
+#endif
+{ }
+
+/**
+ * Destructor
+ */
+Engine::MappedFile::~MappedFile()
+{
+	Close();
+}
+
+/**
+ * Open()
+ * Maps a file into memory, closing whatever was open before.
+ * @param filename The path to the file.
+ * @return True if the file was mapped, false if it doesn't exist or couldn't be mapped.
+ */
+bool Engine::MappedFile::Open(const std::string& filename)
+{
+	Close();
+
+#ifdef _WIN32
+	file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize))
+	{
+		Close();
+		return false;
+	}
+
+	if (fileSize.QuadPart == 0)
+	{
+		data = EMPTY_FILE;
+		return true;
+	}
+
+	mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mapping == NULL)
+	{
+		Close();
+		return false;
+	}
+
+	data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+	if (data == nullptr)
+	{
+		Close();
+		return false;
+	}
+	size = (size_t)fileSize.QuadPart;
+#else
+	int file = open(filename.c_str(), O_RDONLY);
+	if (file < 0)
+		return false;
+
+	struct stat status;
+	if (fstat(file, &status) != 0)
+	{
+		close(file);
+		return false;
+	}
+
+	if (status.st_size == 0)
+	{
+		close(file);
+		data = EMPTY_FILE;
+		return true;
+	}
+
+	// The mapping keeps the file alive, so the descriptor isn't needed once it is made
+	void* view = mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+	close(file);
+	if (view == MAP_FAILED)
+		return false;
+
+	data = static_cast<const char*>(view);
+	size = (size_t)status.st_size;
+#endif
+
+	return true;
+}
+
+/**
+ * Close()
+ * Unmaps the file, if one is open.
+ */
+void Engine::MappedFile::Close()
+{
+#ifdef _WIN32
+	if (data != nullptr && data != EMPTY_FILE)
+		UnmapViewOfFile(data);
+	if (mapping != NULL)
+		CloseHandle(mapping);
+	if (file != INVALID_HANDLE_VALUE)
+		CloseHandle(file);
+
+	mapping = NULL;
+	file = INVALID_HANDLE_VALUE;
+#else
+	if (data != nullptr && data != EMPTY_FILE)
+		munmap(const_cast<char*>(data), size);
+#endif
+
+	data = nullptr;
+	size = 0;
+}
+
+/**
+ * Data()
+ * @return The contents of the file, or nullptr if nothing is open. Not null terminated.
+ */
+const char* Engine::MappedFile::Data() const { return data; }
+
+/**
+ * Size()
+ * @return The size of the file in bytes.
+ */
+size_t Engine::MappedFile::Size() const { return size; }
\ No newline at end of file
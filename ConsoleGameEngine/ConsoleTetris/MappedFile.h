@@ -0,0 +1,36 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+namespace Engine
+{
+	/**
+	 * MappedFile
+	 * A whole file mapped read-only into memory, so it can be read in place without being copied into a buffer first.
+	 * The mapping is released when the MappedFile is closed or destroyed.
+	 */
+	class MappedFile
+	{
+	private:
+		const char* data;
+		size_t size;
+
+#ifdef _WIN32
+		void* file;
+		void* mapping;
+#endif
+
+	public:
+		MappedFile(void);
+		~MappedFile(void);
+
+		bool Open(const std::string& filename);
+		void Close(void);
+
+		const char* Data(void) const;
+		size_t Size(void) const;
+
+		MappedFile(MappedFile const&) = delete;
+		void operator=(MappedFile const&) = delete;
+	};
+}
\ No newline at end of file
@@ -2,28 +2,182 @@
 #include <math.h>
 
 #include "Defines.h"
+#include "FVector3.h"
 
 namespace Engine { namespace Physics {
-	struct FVector3;
+	/**
+	 * Matrix4x4
+	 * A row-major 4x4 matrix, applied to row vectors (v * M). Like the vectors it is a plain value type defined entirely here,
+	 * so every construction function and product returns by value and can be inlined.
+	 */
 	class Matrix4x4
 	{
 	public:
 		float matrix[4][4];
 
-		Matrix4x4(void);
+		constexpr Matrix4x4(void) : matrix{ { 0.0f, 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f, 0.0f } } { }
 
 		// Matrix Construction Functions
-		static Matrix4x4& IdentityMatrix(void);
-		static Matrix4x4& TranslationMatrix(const float& x, const float& y, const float& z);
-		static Matrix4x4& RotationXMatrix(const float& angle);
-		static Matrix4x4& RotationYMatrix(const float& angle);
-		static Matrix4x4& RotationZMatrix(const float& angle);
-		static Matrix4x4& ProjectionMatrix(const float& aspectRatio, const float& fov, const float& nearClipping, const float& farClipping);
-		static Matrix4x4& PointAtMatrix(const FVector3& position, const FVector3& target, const FVector3& up);
-		static Matrix4x4& InvertPointAtMatrix(const Matrix4x4& pointAt);
+		static constexpr Matrix4x4 IdentityMatrix(void)
+		{
+			Matrix4x4 matrix;
+			matrix.matrix[0][0] = 1.0f;
+			matrix.matrix[1][1] = 1.0f;
+			matrix.matrix[2][2] = 1.0f;
+			matrix.matrix[3][3] = 1.0f;
+			return matrix;
+		}
+
+		static constexpr Matrix4x4 TranslationMatrix(const float& x, const float& y, const float& z)
+		{
+			Matrix4x4 matrix = IdentityMatrix();
+			matrix.matrix[3][0] = x;
+			matrix.matrix[3][1] = y;
+			matrix.matrix[3][2] = z;
+			return matrix;
+		}
+
+		static Matrix4x4 RotationXMatrix(const float& angle)
+		{
+			Matrix4x4 matrix;
+			matrix.matrix[0][0] = 1.0f;
+			matrix.matrix[1][1] = cosf(angle);
+			matrix.matrix[1][2] = sinf(angle);
+			matrix.matrix[2][1] = -sinf(angle);
+			matrix.matrix[2][2] = cosf(angle);
+			matrix.matrix[3][3] = 1.0f;
+			return matrix;
+		}
+
+		static Matrix4x4 RotationYMatrix(const float& angle)
+		{
+			Matrix4x4 matrix;
+			matrix.matrix[0][0] = cosf(angle);
+			matrix.matrix[0][2] = sinf(angle);
+			matrix.matrix[2][0] = -sinf(angle);
+			matrix.matrix[1][1] = 1.0f;
+			matrix.matrix[2][2] = cosf(angle);
+			matrix.matrix[3][3] = 1.0f;
+			return matrix;
+		}
+
+		static Matrix4x4 RotationZMatrix(const float& angle)
+		{
+			Matrix4x4 matrix;
+			matrix.matrix[0][0] = cosf(angle);
+			matrix.matrix[0][1] = sinf(angle);
+			matrix.matrix[1][0] = -sinf(angle);
+			matrix.matrix[1][1] = cosf(angle);
+			matrix.matrix[2][2] = 1.0f;
+			matrix.matrix[3][3] = 1.0f;
+			return matrix;
+		}
+
+		static Matrix4x4 ProjectionMatrix(const float& aspectRatio, const float& fov, const float& nearClipping, const float& farClipping)
+		{
+			float fovRad = 1.0f / tanf(fov * 0.5f / 180.0f * PI);
+			Matrix4x4 matrix;
+			matrix.matrix[0][0] = aspectRatio * fovRad;
+			matrix.matrix[1][1] = fovRad;
+			matrix.matrix[2][2] = farClipping / (farClipping - nearClipping);
+			matrix.matrix[3][2] = (-farClipping * nearClipping) / (farClipping - nearClipping);
+			matrix.matrix[2][3] = 1.0f;
+			return matrix;
+		}
+
+		static Matrix4x4 PointAtMatrix(const FVector3& position, const FVector3& target, const FVector3& up)
+		{
+			// Calculate forward, new up and right directions.
+			FVector3 forward = (target - position).Normalized();
+			FVector3 newUp = (up - (forward * up.DotProduct(forward))).Normalized();
+			FVector3 right = newUp.CrossProduct(forward);
+
+			// Construct point at matrix.
+			Matrix4x4 matrix;
+			matrix.matrix[0][0] = right.x;    matrix.matrix[0][1] = right.y;    matrix.matrix[0][2] = right.z;
+			matrix.matrix[1][0] = newUp.x;    matrix.matrix[1][1] = newUp.y;    matrix.matrix[1][2] = newUp.z;
+			matrix.matrix[2][0] = forward.x;  matrix.matrix[2][1] = forward.y;  matrix.matrix[2][2] = forward.z;
+			matrix.matrix[3][0] = position.x; matrix.matrix[3][1] = position.y; matrix.matrix[3][2] = position.z;
+			matrix.matrix[3][3] = 1.0f;
+			return matrix;
+		}
+
+		/**
+		 * InvertPointAtMatrix()
+		 * Inverts a rotation and translation only matrix, such as one made by PointAtMatrix(), to give a view matrix.
+		 */
+		static constexpr Matrix4x4 InvertPointAtMatrix(const Matrix4x4& pointAt)
+		{
+			Matrix4x4 matrix;
+			matrix.matrix[0][0] = pointAt.matrix[0][0]; matrix.matrix[0][1] = pointAt.matrix[1][0]; matrix.matrix[0][2] = pointAt.matrix[2][0];
+			matrix.matrix[1][0] = pointAt.matrix[0][1]; matrix.matrix[1][1] = pointAt.matrix[1][1]; matrix.matrix[1][2] = pointAt.matrix[2][1];
+			matrix.matrix[2][0] = pointAt.matrix[0][2]; matrix.matrix[2][1] = pointAt.matrix[1][2]; matrix.matrix[2][2] = pointAt.matrix[2][2];
+			matrix.matrix[3][0] = -(pointAt.matrix[3][0] * matrix.matrix[0][0] + pointAt.matrix[3][1] * matrix.matrix[1][0] + pointAt.matrix[3][2] * matrix.matrix[2][0]);
+			matrix.matrix[3][1] = -(pointAt.matrix[3][0] * matrix.matrix[0][1] + pointAt.matrix[3][1] * matrix.matrix[1][1] + pointAt.matrix[3][2] * matrix.matrix[2][1]);
+			matrix.matrix[3][2] = -(pointAt.matrix[3][0] * matrix.matrix[0][2] + pointAt.matrix[3][1] * matrix.matrix[1][2] + pointAt.matrix[3][2] * matrix.matrix[2][2]);
+			matrix.matrix[3][3] = 1.0f;
+			return matrix;
+		}
+
+		// Misc Functions
+
+		/**
+		 * MaxScale()
+		 * @return The most the matrix stretches any direction by, e.g. for growing a bounding sphere to match.
+		 */
+		float MaxScale(void) const
+		{
+			float largest = 0.0f;
+			for (int row = 0; row < 3; ++row)
+			{
+				float lengthSquared = (matrix[row][0] * matrix[row][0]) + (matrix[row][1] * matrix[row][1]) + (matrix[row][2] * matrix[row][2]);
+				largest = (lengthSquared > largest) ? lengthSquared : largest;
+			}
+			return sqrtf(largest);
+		}
 
 		// Operator Overloads
-		Matrix4x4& operator*(const Matrix4x4& other) const;
-		Matrix4x4& operator*=(const Matrix4x4& other);
+		constexpr Matrix4x4 operator*(const Matrix4x4& other) const
+		{
+			Matrix4x4 output;
+			for (int x = 0; x < 4; ++x)
+				for (int y = 0; y < 4; ++y)
+					output.matrix[y][x] = (matrix[y][0] * other.matrix[0][x]) + (matrix[y][1] * other.matrix[1][x]) + (matrix[y][2] * other.matrix[2][x]) + (matrix[y][3] * other.matrix[3][x]);
+
+			return output;
+		}
+
+		constexpr Matrix4x4& operator*=(const Matrix4x4& other)
+		{
+			// Multiply into a copy - every element of a row is read while working out each element of the same row
+			*this = *this * other;
+			return *this;
+		}
 	};
-}}
\ No newline at end of file
+
+	/**
+	 * operator*()
+	 * Transforms a point by a matrix, dividing through by w if the matrix is a projection.
+	 * @param point The point to transform.
+	 * @param matrix The matrix to transform it by.
+	 * @return The transformed point.
+	 */
+	constexpr FVector3 operator*(const FVector3& point, const Matrix4x4& matrix)
+	{
+		FVector3 output((point.x * matrix.matrix[0][0]) + (point.y * matrix.matrix[1][0]) + (point.z * matrix.matrix[2][0]) + matrix.matrix[3][0],
+						(point.x * matrix.matrix[0][1]) + (point.y * matrix.matrix[1][1]) + (point.z * matrix.matrix[2][1]) + matrix.matrix[3][1],
+						(point.x * matrix.matrix[0][2]) + (point.y * matrix.matrix[1][2]) + (point.z * matrix.matrix[2][2]) + matrix.matrix[3][2]);
+		float w =        (point.x * matrix.matrix[0][3]) + (point.y * matrix.matrix[1][3]) + (point.z * matrix.matrix[2][3]) + matrix.matrix[3][3];
+
+		if (w != 0.0f && w != 1.0f)
+			output /= w;
+
+		return output;
+	}
+
+	constexpr FVector3& operator*=(FVector3& point, const Matrix4x4& matrix)
+	{
+		point = point * matrix;
+		return point;
+	}
+} }
\ No newline at end of file
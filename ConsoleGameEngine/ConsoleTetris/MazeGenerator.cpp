@@ -0,0 +1,397 @@
+#include <cstring>
+
+#include "MazeGenerator.h"
+
+typedef Engine::MazeGrid::Direction Direction;
+
+// HELPERS #####################################################################################################################################################
+
+/*
+ * GetBit()
+ * @param bits A bit array.
+ * @param index The bit.
+ * @return True if the bit is set.
+ */
+static inline bool GetBit(const std::vector<uint64_t>& bits, const size_t& index) { return ((bits[index / 64] >> (index % 64)) & 1) != 0; }
+
+/*
+ * SetBit()
+ * @param bits A bit array.
+ * @param index The bit to set.
+ */
+static inline void SetBit(std::vector<uint64_t>& bits, const size_t& index) { bits[index / 64] |= 1ULL << (index % 64); }
+
+/*
+ * FindRoot()
+ * Finds the set a union-find element is in, halving the path to it on the way so later finds are quicker.
+ * @param parent Each element's parent, roots pointing at themselves.
+ * @param element The element.
+ * @return The root of the element's set.
+ */
+template <typename Index>
+static inline Index FindRoot(std::vector<Index>& parent, Index element)
+{
+	while (parent[element] != element)
+	{
+		parent[element] = parent[parent[element]];
+		element = parent[element];
+	}
+	return element;
+}
+
+/*
+ * Neighbours()
+ * Lists the sides of a cell that lead to another cell in the maze.
+ * @param x, y The cell.
+ * @param width, height The size of the maze.
+ * @param directions Set to the sides, up to 4 of them.
+ * @return The number of sides.
+ */
+static inline int Neighbours(const int& x, const int& y, const int& width, const int& height, Direction* directions)
+{
+	int count = 0;
+	if (y > 0) directions[count++] = Direction::North;
+	if (x < width - 1) directions[count++] = Direction::East;
+	if (y < height - 1) directions[count++] = Direction::South;
+	if (x > 0) directions[count++] = Direction::West;
+	return count;
+}
+
+/*
+ * Step()
+ * @param cell A cell, as y * width + x.
+ * @param direction Which way to move.
+ * @param width The width of the maze.
+ * @return The cell next to it on that side.
+ */
+static inline size_t Step(const size_t& cell, const Direction& direction, const int& width)
+{
+	switch (direction)
+	{
+	case Direction::North: return cell - width;
+	case Direction::East: return cell + 1;
+	case Direction::South: return cell + width;
+	default: return cell - 1;
+	}
+}
+
+// GENERATOR ###################################################################################################################################################
+
+/*
+ * Generate()
+ * Puts every wall of the maze up, then carves a new maze into it.
+ * @param maze The maze to carve.
+ * @param algorithm How to carve it.
+ * @param random Where the random choices come from.
+ */
+void Engine::MazeGenerator::Generate(MazeGrid& maze, const Algorithm& algorithm, XorShift& random)
+{
+	switch (algorithm)
+	{
+	case Algorithm::Backtracker: Backtracker(maze, random); break;
+	case Algorithm::Wilson: Wilson(maze, random); break;
+	case Algorithm::Eller: Eller(maze, random); break;
+	case Algorithm::Kruskal: Kruskal(maze, random); break;
+	}
+}
+
+/*
+ * AlgorithmName()
+ * @param algorithm The algorithm.
+ * @return The algorithm's name.
+ */
+const char* Engine::MazeGenerator::AlgorithmName(const Algorithm& algorithm)
+{
+	switch (algorithm)
+	{
+	case Algorithm::Backtracker: return "Backtracker";
+	case Algorithm::Wilson: return "Wilson";
+	case Algorithm::Eller: return "Eller";
+	default: return "Kruskal";
+	}
+}
+
+/*
+ * Backtracker()
+ * Walks from a random cell into random unvisited neighbours, carving as it goes, and backs up along the path when it gets stuck.
+ * The path is kept as a stack of cell numbers rather than positions.
+ * @param maze The maze to carve.
+ * @param random Where the random choices come from.
+ */
+void Engine::MazeGenerator::Backtracker(MazeGrid& maze, XorShift& random)
+{
+	maze.Fill();
+	int width = maze.Width(), height = maze.Height();
+	size_t cellCount = (size_t)width * (size_t)height;
+	if (cellCount == 0)
+		return;
+
+	std::vector<uint64_t> visited((cellCount + 63) / 64, 0);
+	std::vector<uint32_t> path;
+	path.reserve((width > height) ? width : height);
+
+	uint32_t start = (uint32_t)random.NextBelow((uint32_t)cellCount);
+	SetBit(visited, start);
+	path.push_back(start);
+
+	while (!path.empty())
+	{
+		uint32_t cell = path.back();
+		int x = (int)(cell % width), y = (int)(cell / width);
+
+		Direction sides[4];
+		Direction options[4];
+		int optionCount = 0;
+		int sideCount = Neighbours(x, y, width, height, sides);
+		for (int i = 0; i < sideCount; ++i)
+			if (!GetBit(visited, Step(cell, sides[i], width)))
+				options[optionCount++] = sides[i];
+
+		if (optionCount == 0)
+		{
+			path.pop_back();
+			continue;
+		}
+
+		Direction direction = options[random.NextBelow(optionCount)];
+		uint32_t next = (uint32_t)Step(cell, direction, width);
+		maze.Carve(x, y, direction);
+		SetBit(visited, next);
+		path.push_back(next);
+	}
+}
+
+/*
+ * Wilson()
+ * Starts the maze with one random cell, then from each cell not yet in it takes a random walk until it hits the maze.
+ * Each cell only remembers the way it was last left, which erases any loops in the walk, and the walk is then carved in.
+ * @param maze The maze to carve.
+ * @param random Where the random choices come from.
+ */
+void Engine::MazeGenerator::Wilson(MazeGrid& maze, XorShift& random)
+{
+	maze.Fill();
+	int width = maze.Width(), height = maze.Height();
+	size_t cellCount = (size_t)width * (size_t)height;
+	if (cellCount == 0)
+		return;
+
+	std::vector<uint64_t> inMaze((cellCount + 63) / 64, 0);
+	std::vector<unsigned char> exits(cellCount, 0);
+	SetBit(inMaze, random.NextBelow((uint32_t)cellCount));
+
+	for (size_t start = 0; start < cellCount; ++start)
+	{
+		if (GetBit(inMaze, start))
+			continue;
+
+		// Walk until the maze is hit, the last exit from each cell overwriting any loop through it
+		size_t cell = start;
+		while (!GetBit(inMaze, cell))
+		{
+			Direction sides[4];
+			int sideCount = Neighbours((int)(cell % width), (int)(cell / width), width, height, sides);
+			Direction direction = sides[random.NextBelow(sideCount)];
+			exits[cell] = (unsigned char)direction;
+			cell = Step(cell, direction, width);
+		}
+
+		// Follow the exits from the start again, carving the loop free path into the maze
+		cell = start;
+		while (!GetBit(inMaze, cell))
+		{
+			Direction direction = (Direction)exits[cell];
+			SetBit(inMaze, cell);
+			maze.Carve((int)(cell % width), (int)(cell / width), direction);
+			cell = Step(cell, direction, width);
+		}
+	}
+}
+
+/*
+ * Eller()
+ * Carves the maze a row at a time with EllerRows, writing each row straight into the maze.
+ * @param maze The maze to carve.
+ * @param random Where the random choices come from.
+ */
+void Engine::MazeGenerator::Eller(MazeGrid& maze, XorShift& random)
+{
+	maze.Fill();
+	EllerRows rows(maze.Width(), maze.Height(), random);
+	for (int y = 0; y < maze.Height(); ++y)
+		rows.NextRow(maze.EastWallRow(y), maze.SouthWallRow(y));
+}
+
+/*
+ * Kruskal()
+ * Goes through every inside wall in a random order, knocking it down if the cells either side aren't joined yet.
+ * Which cells are joined is tracked with a union-find, so each check is close to constant time.
+ * @param maze The maze to carve.
+ * @param random Where the random choices come from.
+ */
+void Engine::MazeGenerator::Kruskal(MazeGrid& maze, XorShift& random)
+{
+	maze.Fill();
+	int width = maze.Width(), height = maze.Height();
+	size_t cellCount = (size_t)width * (size_t)height;
+	if (cellCount == 0)
+		return;
+
+	// Each wall is its cell * 2, plus 1 for the south wall rather than the east one
+	std::vector<uint32_t> walls;
+	walls.reserve(cellCount * 2);
+	for (int y = 0; y < height; ++y)
+	{
+		for (int x = 0; x < width; ++x)
+		{
+			uint32_t cell = (uint32_t)(((size_t)y * width) + x);
+			if (x < width - 1)
+				walls.push_back(cell * 2);
+			if (y < height - 1)
+				walls.push_back((cell * 2) + 1);
+		}
+	}
+
+	// Fisher-Yates shuffle
+	for (size_t i = walls.size(); i > 1; --i)
+	{
+		size_t j = random.NextBelow((uint32_t)i);
+		uint32_t swap = walls[i - 1];
+		walls[i - 1] = walls[j];
+		walls[j] = swap;
+	}
+
+	std::vector<uint32_t> parent(cellCount);
+	std::vector<unsigned char> rank(cellCount, 0);
+	for (size_t i = 0; i < cellCount; ++i)
+		parent[i] = (uint32_t)i;
+
+	size_t joined = 0;
+	for (size_t i = 0; i < walls.size() && joined < cellCount - 1; ++i)
+	{
+		uint32_t cell = walls[i] / 2;
+		bool south = (walls[i] & 1) != 0;
+		uint32_t rootA = FindRoot(parent, cell);
+		uint32_t rootB = FindRoot(parent, south ? cell + (uint32_t)width : cell + 1);
+		if (rootA == rootB)
+			continue;
+
+		// Union by rank keeps the trees shallow
+		if (rank[rootA] < rank[rootB])
+			parent[rootA] = rootB;
+		else
+		{
+			parent[rootB] = rootA;
+			if (rank[rootA] == rank[rootB])
+				++rank[rootA];
+		}
+
+		maze.Carve((int)(cell % width), (int)(cell / width), south ? Direction::South : Direction::East);
+		++joined;
+	}
+}
+
+// ELLER ROWS ##################################################################################################################################################
+
+/**
+ * Constructor
+ * @param width The number of cells across.
+ * @param height The number of rows to hand out.
+ * @param random Where the random choices come from. Must outlive the EllerRows.
+ */
+Engine::EllerRows::EllerRows(const int& width, const int& height, XorShift& random) : width(width), height(height), row(0), random(random),
+	labels(width, -1), parent(width), remaining(width), firstColumn(width), carvedDown(width) { }
+
+/*
+ * Find()
+ * @param label A set in the current row.
+ * @return The set it has been joined into.
+ */
+int Engine::EllerRows::Find(int label) { return FindRoot(parent, label); }
+
+/*
+ * Row()
+ * @return The row the next call to NextRow() will hand out.
+ */
+int Engine::EllerRows::Row() const { return row; }
+
+/*
+ * NextRow()
+ * Carves the next row: randomly joins neighbouring cells in different sets, then carves at least one way down from every set.
+ * The last row joins every set still apart, so the whole maze ends up connected.
+ * @param eastWalls Set to the row's east walls, packed like a MazeGrid row.
+ * @param southWalls Set to the row's south walls, packed like a MazeGrid row.
+ * @return False once every row has been handed out, in which case nothing is written.
+ */
+bool Engine::EllerRows::NextRow(uint64_t* eastWalls, uint64_t* southWalls)
+{
+	if (row >= height)
+		return false;
+
+	int words = (width + 63) / 64;
+	bool lastRow = row == height - 1;
+	memset(eastWalls, 0xFF, sizeof(uint64_t) * words);
+	memset(southWalls, 0xFF, sizeof(uint64_t) * words);
+
+	// New cells start their own set, labelled by their column, which can't be the first column of any set carried down
+	for (int x = 0; x < width; ++x)
+	{
+		if (labels[x] < 0)
+			labels[x] = x;
+		parent[x] = x;
+	}
+
+	// Join neighbours across, always on the last row
+	for (int x = 0; x < width - 1; ++x)
+	{
+		int setA = Find(labels[x]), setB = Find(labels[x + 1]);
+		if (setA == setB || !(lastRow || random.NextBool()))
+			continue;
+
+		eastWalls[x / 64] &= ~(1ULL << (x % 64));
+		parent[setB] = setA;
+	}
+
+	if (!lastRow)
+	{
+		for (int x = 0; x < width; ++x)
+		{
+			int set = Find(labels[x]);
+			remaining[set] = 0;
+			carvedDown[set] = 0;
+		}
+		for (int x = 0; x < width; ++x)
+			++remaining[Find(labels[x])];
+
+		// Carve down at random, forcing it on a set's last cell if none of the others did
+		for (int x = 0; x < width; ++x)
+		{
+			int set = Find(labels[x]);
+			--remaining[set];
+			if (random.NextBool() || (remaining[set] == 0 && !carvedDown[set]))
+			{
+				southWalls[x / 64] &= ~(1ULL << (x % 64));
+				carvedDown[set] = 1;
+				labels[x] = set;
+			}
+			else
+				labels[x] = -1;
+		}
+
+		// Relabel the sets carried down by their first column, so labels stay under the width
+		for (int x = 0; x < width; ++x)
+			if (labels[x] >= 0)
+				firstColumn[labels[x]] = -1;
+		for (int x = 0; x < width; ++x)
+		{
+			if (labels[x] < 0)
+				continue;
+			if (firstColumn[labels[x]] < 0)
+				firstColumn[labels[x]] = x;
+			labels[x] = firstColumn[labels[x]];
+		}
+	}
+
+	++row;
+	return true;
+}
\ No newline at end of file
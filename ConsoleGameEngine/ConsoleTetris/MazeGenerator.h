@@ -0,0 +1,76 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "MazeGrid.h"
+#include "XorShift.h"
+
+namespace Engine
+{
+	/**
+	 * MazeGenerator
+	 * Carves a whole perfect maze (exactly one path between any two cells) into a MazeGrid in one call.
+	 * Each algorithm gives mazes with a different feel:
+	 * Backtracker - long winding corridors with few dead ends.
+	 * Wilson      - an unbiased pick from every possible maze, slower to start on big mazes.
+	 * Eller       - built a row at a time with memory for one row, so mazes can be streamed out. See EllerRows.
+	 * Kruskal     - lots of short dead ends, from joining cells in a random order.
+	 */
+	class MazeGenerator
+	{
+	public:
+		/**
+		 * Algorithm
+		 * The ways Generate() can carve a maze.
+		 */
+		enum class Algorithm
+		{
+			Backtracker,
+			Wilson,
+			Eller,
+			Kruskal
+		};
+
+		static void Generate(MazeGrid& maze, const Algorithm& algorithm, XorShift& random);
+		static const char* AlgorithmName(const Algorithm& algorithm);
+
+		static void Backtracker(MazeGrid& maze, XorShift& random);
+		static void Wilson(MazeGrid& maze, XorShift& random);
+		static void Eller(MazeGrid& maze, XorShift& random);
+		static void Kruskal(MazeGrid& maze, XorShift& random);
+	};
+
+	/**
+	 * EllerRows
+	 * Eller's algorithm, handing out one row of walls at a time. Only the sets of the current row are kept,
+	 * so the memory used depends on the width of the maze and not its height.
+	 */
+	class EllerRows
+	{
+	private:
+		int width;
+		int height;
+		int row;
+		XorShift& random;
+
+		// Which set each cell of the current row is in, by the column of the set's first cell, or -1 for a new set
+		std::vector<int> labels;
+
+		// Per set, joined sets pointing towards the one that absorbed them
+		std::vector<int> parent;
+		std::vector<int> remaining;
+		std::vector<int> firstColumn;
+		std::vector<unsigned char> carvedDown;
+
+		int Find(int label);
+
+	public:
+		EllerRows(const int& width, const int& height, XorShift& random);
+
+		int Row(void) const;
+		bool NextRow(uint64_t* eastWalls, uint64_t* southWalls);
+
+		EllerRows(EllerRows const&) = delete;
+		void operator=(EllerRows const&) = delete;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,161 @@
+#include <cstring>
+
+#include "MazeGrid.h"
+
+/*
+ * CountZeros()
+ * @param row A row of walls.
+ * @param count How many bits of the row to look at.
+ * @return The number of carved walls among them.
+ */
+static size_t CountZeros(const uint64_t* row, const int& count)
+{
+	size_t zeros = 0;
+	for (int i = 0; i * 64 < count; ++i)
+	{
+		int bits = (count - (i * 64) < 64) ? count - (i * 64) : 64;
+		uint64_t mask = (bits == 64) ? ~0ULL : (1ULL << bits) - 1;
+		for (uint64_t word = ~row[i] & mask; word != 0; word &= word - 1)
+			++zeros;
+	}
+	return zeros;
+}
+
+/**
+ * Constructor
+ * Starts with every wall up.
+ * @param width The number of cells across. Negative sizes are treated as 0, giving an empty maze.
+ * @param height The number of cells down.
+ */
+Engine::MazeGrid::MazeGrid(const int& width, const int& height) : width(width > 0 ? width : 0), height(height > 0 ? height : 0)
+{
+	words = (this->width + 63) / 64;
+	eastWalls = new uint64_t[(size_t)words * (size_t)this->height];
+	southWalls = new uint64_t[(size_t)words * (size_t)this->height];
+	Fill();
+}
+
+/**
+ * Destructor
+ */
+Engine::MazeGrid::~MazeGrid()
+{
+	delete[] eastWalls;
+	delete[] southWalls;
+}
+
+/*
+ * Width()
+ * @return The number of cells across.
+ */
+int Engine::MazeGrid::Width() const { return width; }
+
+/*
+ * Height()
+ * @return The number of cells down.
+ */
+int Engine::MazeGrid::Height() const { return height; }
+
+/*
+ * WordsPerRow()
+ * @return The number of words each row of walls is packed into.
+ */
+int Engine::MazeGrid::WordsPerRow() const { return words; }
+
+/*
+ * Fill()
+ * Puts every wall back up.
+ */
+void Engine::MazeGrid::Fill()
+{
+	memset(eastWalls, 0xFF, sizeof(uint64_t) * (size_t)words * (size_t)height);
+	memset(southWalls, 0xFF, sizeof(uint64_t) * (size_t)words * (size_t)height);
+}
+
+/*
+ * HasWall()
+ * @param x The column of the cell.
+ * @param y The row of the cell.
+ * @param direction The side of the cell.
+ * @return True if there is a wall on that side. Cells outside the maze are walled in on every side.
+ */
+bool Engine::MazeGrid::HasWall(const int& x, const int& y, const Direction& direction) const
+{
+	if (x < 0 || x >= width || y < 0 || y >= height)
+		return true;
+
+	switch (direction)
+	{
+	case Direction::North: return y == 0 || ((southWalls[((size_t)(y - 1) * words) + (x / 64)] >> (x % 64)) & 1) != 0;
+	case Direction::East: return ((eastWalls[((size_t)y * words) + (x / 64)] >> (x % 64)) & 1) != 0;
+	case Direction::South: return ((southWalls[((size_t)y * words) + (x / 64)] >> (x % 64)) & 1) != 0;
+	default: return x == 0 || ((eastWalls[((size_t)y * words) + ((x - 1) / 64)] >> ((x - 1) % 64)) & 1) != 0;
+	}
+}
+
+/*
+ * Carve()
+ * Knocks down one side of a cell, joining it to the cell next to it. Walls around the outside of the maze are left standing.
+ * @param x The column of the cell.
+ * @param y The row of the cell.
+ * @param direction The side of the cell.
+ */
+void Engine::MazeGrid::Carve(const int& x, const int& y, const Direction& direction)
+{
+	if (x < 0 || x >= width || y < 0 || y >= height)
+		return;
+
+	switch (direction)
+	{
+	case Direction::North:
+		if (y > 0)
+			southWalls[((size_t)(y - 1) * words) + (x / 64)] &= ~(1ULL << (x % 64));
+		break;
+	case Direction::East:
+		if (x < width - 1)
+			eastWalls[((size_t)y * words) + (x / 64)] &= ~(1ULL << (x % 64));
+		break;
+	case Direction::South:
+		if (y < height - 1)
+			southWalls[((size_t)y * words) + (x / 64)] &= ~(1ULL << (x % 64));
+		break;
+	default:
+		if (x > 0)
+			eastWalls[((size_t)y * words) + ((x - 1) / 64)] &= ~(1ULL << ((x - 1) % 64));
+		break;
+	}
+}
+
+/*
+ * PassageCount()
+ * @return The number of walls that have been carved. A perfect maze has one fewer than it has cells.
+ */
+size_t Engine::MazeGrid::PassageCount() const
+{
+	size_t passages = 0;
+	for (int y = 0; y < height; ++y)
+	{
+		passages += CountZeros(EastWallRow(y), width - 1);
+		if (y < height - 1)
+			passages += CountZeros(SouthWallRow(y), width);
+	}
+	return passages;
+}
+
+/*
+ * EastWallRow()
+ * Direct access for code that writes whole rows at once. Bits for the last column and past it must stay set.
+ * @param y The row.
+ * @return The row's east walls, WordsPerRow() words of them, bit x % 64 of word x / 64 set if cell x has a wall to its east.
+ */
+uint64_t* Engine::MazeGrid::EastWallRow(const int& y) { return eastWalls + ((size_t)y * words); }
+const uint64_t* Engine::MazeGrid::EastWallRow(const int& y) const { return eastWalls + ((size_t)y * words); }
+
+/*
+ * SouthWallRow()
+ * Direct access for code that writes whole rows at once. Bits for the last row and past the last column must stay set.
+ * @param y The row.
+ * @return The row's south walls, WordsPerRow() words of them, bit x % 64 of word x / 64 set if cell x has a wall to its south.
+ */
+uint64_t* Engine::MazeGrid::SouthWallRow(const int& y) { return southWalls + ((size_t)y * words); }
+const uint64_t* Engine::MazeGrid::SouthWallRow(const int& y) const { return southWalls + ((size_t)y * words); }
\ No newline at end of file
@@ -0,0 +1,57 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace Engine
+{
+	/**
+	 * MazeGrid
+	 * The walls of a rectangular maze packed one bit per wall. Every cell owns the walls on its east and south sides,
+	 * in two bit arrays laid out like a LifeGrid's rows (bit x % 64 of word x / 64), so a million cell maze needs 256KB.
+	 * The walls around the outside of the maze can never be carved.
+	 */
+	class MazeGrid
+	{
+	public:
+		/**
+		 * Direction
+		 * The sides of a cell.
+		 */
+		enum class Direction
+		{
+			North,
+			East,
+			South,
+			West
+		};
+
+	private:
+		int width;
+		int height;
+		int words;
+
+		uint64_t* eastWalls;
+		uint64_t* southWalls;
+
+	public:
+		MazeGrid(const int& width, const int& height);
+		~MazeGrid(void);
+
+		int Width(void) const;
+		int Height(void) const;
+		int WordsPerRow(void) const;
+
+		void Fill(void);
+		bool HasWall(const int& x, const int& y, const Direction& direction) const;
+		void Carve(const int& x, const int& y, const Direction& direction);
+		size_t PassageCount(void) const;
+
+		uint64_t* EastWallRow(const int& y);
+		uint64_t* SouthWallRow(const int& y);
+		const uint64_t* EastWallRow(const int& y) const;
+		const uint64_t* SouthWallRow(const int& y) const;
+
+		MazeGrid(MazeGrid const&) = delete;
+		void operator=(MazeGrid const&) = delete;
+	};
+}
\ No newline at end of file
@@ -1,36 +1,813 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unordered_map>
+
+#include "MappedFile.h"
 #include "Mesh.h"
 
-bool Engine::Graphics::Mesh::LoadFromObjFile(std::string filename)
+#if defined(__AVX__)
+#include <immintrin.h>
+#define MESH_SIMD_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MESH_SIMD_SSE
+#endif
+
+// How many instances TransformInstances() works on together
+static const size_t TRANSFORM_INSTANCE_BLOCK = 8;
+
+// SIMD LANES ##################################################################################################################################################
+
+// A few wrappers so the vertex transform is written once for both 8 wide AVX and 4 wide SSE
+#if defined(MESH_SIMD_AVX)
+typedef __m256 Lanes;
+static const size_t LANE_COUNT = 8;
+static inline Lanes LoadLanes(const float* source) { return _mm256_loadu_ps(source); }
+static inline void StoreLanes(float* destination, const Lanes& value) { _mm256_storeu_ps(destination, value); }
+static inline Lanes SetLanes(const float& value) { return _mm256_set1_ps(value); }
+static inline Lanes AddLanes(const Lanes& a, const Lanes& b) { return _mm256_add_ps(a, b); }
+static inline Lanes MulLanes(const Lanes& a, const Lanes& b) { return _mm256_mul_ps(a, b); }
+static inline Lanes DivideUnlessZero(const Lanes& value, const Lanes& divisor)
+{
+	Lanes isZero = _mm256_cmp_ps(divisor, _mm256_setzero_ps(), _CMP_EQ_OQ);
+	return _mm256_blendv_ps(_mm256_div_ps(value, divisor), value, isZero);
+}
+#elif defined(MESH_SIMD_SSE)
+typedef __m128 Lanes;
+static const size_t LANE_COUNT = 4;
+static inline Lanes LoadLanes(const float* source) { return _mm_loadu_ps(source); }
+static inline void StoreLanes(float* destination, const Lanes& value) { _mm_storeu_ps(destination, value); }
+static inline Lanes SetLanes(const float& value) { return _mm_set1_ps(value); }
+static inline Lanes AddLanes(const Lanes& a, const Lanes& b) { return _mm_add_ps(a, b); }
+static inline Lanes MulLanes(const Lanes& a, const Lanes& b) { return _mm_mul_ps(a, b); }
+static inline Lanes DivideUnlessZero(const Lanes& value, const Lanes& divisor)
+{
+	Lanes isZero = _mm_cmpeq_ps(divisor, _mm_setzero_ps());
+	return _mm_or_ps(_mm_and_ps(isZero, value), _mm_andnot_ps(isZero, _mm_div_ps(value, divisor)));
+}
+#endif
+
+#if defined(MESH_SIMD_AVX) || defined(MESH_SIMD_SSE)
+/*
+ * MatrixLanes
+ * A Matrix4x4 with every element broadcast across the lanes, made once per transform.
+ */
+struct MatrixLanes
+{
+	Lanes m[4][4];
+	bool affine;
+
+	MatrixLanes(const Engine::Physics::Matrix4x4& matrix)
+	{
+		for (int row = 0; row < 4; ++row)
+			for (int column = 0; column < 4; ++column)
+				m[row][column] = SetLanes(matrix.matrix[row][column]);
+
+		// Matrices that don't touch w (everything but a projection) always give w = 1, so the divide can be skipped
+		affine = matrix.matrix[0][3] == 0.0f && matrix.matrix[1][3] == 0.0f && matrix.matrix[2][3] == 0.0f && matrix.matrix[3][3] == 1.0f;
+	}
+};
+
+/*
+ * TransformLanes()
+ * Transforms a batch of points by a matrix in place, in the same order of operations as FVector3 * Matrix4x4 so the results match it exactly.
+ */
+static inline void TransformLanes(Lanes& x, Lanes& y, Lanes& z, const MatrixLanes& matrix)
+{
+	Lanes outX = AddLanes(AddLanes(AddLanes(MulLanes(x, matrix.m[0][0]), MulLanes(y, matrix.m[1][0])), MulLanes(z, matrix.m[2][0])), matrix.m[3][0]);
+	Lanes outY = AddLanes(AddLanes(AddLanes(MulLanes(x, matrix.m[0][1]), MulLanes(y, matrix.m[1][1])), MulLanes(z, matrix.m[2][1])), matrix.m[3][1]);
+	Lanes outZ = AddLanes(AddLanes(AddLanes(MulLanes(x, matrix.m[0][2]), MulLanes(y, matrix.m[1][2])), MulLanes(z, matrix.m[2][2])), matrix.m[3][2]);
+
+	if (!matrix.affine)
+	{
+		Lanes w = AddLanes(AddLanes(AddLanes(MulLanes(x, matrix.m[0][3]), MulLanes(y, matrix.m[1][3])), MulLanes(z, matrix.m[2][3])), matrix.m[3][3]);
+		outX = DivideUnlessZero(outX, w);
+		outY = DivideUnlessZero(outY, w);
+		outZ = DivideUnlessZero(outZ, w);
+	}
+
+	x = outX;
+	y = outY;
+	z = outZ;
+}
+
+/*
+ * ClipLanes()
+ * Transforms a batch of points into clip space, keeping w rather than dividing by it.
+ */
+static inline void ClipLanes(const Lanes& x, const Lanes& y, const Lanes& z, const MatrixLanes& matrix, Lanes& outX, Lanes& outY, Lanes& outZ, Lanes& outW)
+{
+	outX = AddLanes(AddLanes(AddLanes(MulLanes(x, matrix.m[0][0]), MulLanes(y, matrix.m[1][0])), MulLanes(z, matrix.m[2][0])), matrix.m[3][0]);
+	outY = AddLanes(AddLanes(AddLanes(MulLanes(x, matrix.m[0][1]), MulLanes(y, matrix.m[1][1])), MulLanes(z, matrix.m[2][1])), matrix.m[3][1]);
+	outZ = AddLanes(AddLanes(AddLanes(MulLanes(x, matrix.m[0][2]), MulLanes(y, matrix.m[1][2])), MulLanes(z, matrix.m[2][2])), matrix.m[3][2]);
+	outW = AddLanes(AddLanes(AddLanes(MulLanes(x, matrix.m[0][3]), MulLanes(y, matrix.m[1][3])), MulLanes(z, matrix.m[2][3])), matrix.m[3][3]);
+}
+#endif
+
+/**
+ * Constructor
+ */
+Engine::Graphics::Mesh::Mesh() : boundsCentre(), boundsRadius(0.0f) { }
+
+// LOADING #####################################################################################################################################################
+
+/*
+ * MeshCacheHeader
+ * The start of a .meshbin file. The vertex arrays (x, y and z, the normals' x, y and z, then u and v if the mesh is textured) and the index array follow it directly,
+ * laid out exactly as they are in a Mesh, so loading one is a copy with nothing to parse.
+ */
+struct MeshCacheHeader
+{
+	char magic[4];
+	uint32_t version;
+	int64_t sourceSize;
+	int64_t sourceTime;
+	uint32_t vertexCount;
+	uint32_t indexCount;
+	uint32_t texCoordCount;
+	float boundsCentre[3];
+	float boundsRadius;
+};
+
+static const char MESH_CACHE_MAGIC[4] = { 'M', 'B', 'I', 'N' };
+static const uint32_t MESH_CACHE_VERSION = 3;
+
+// Powers of ten that are exact as doubles, for building floats out of their digits
+static const double POWERS_OF_TEN[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+/*
+ * SkipSpaces()
+ * Moves past any spaces and tabs, stopping at the end of the line.
+ */
+static inline void SkipSpaces(const char*& text, const char* end)
+{
+	while (text < end && (*text == ' ' || *text == '\t'))
+		++text;
+}
+
+/*
+ * SkipLine()
+ * Moves to the start of the next line.
+ */
+static inline void SkipLine(const char*& text, const char* end)
+{
+	while (text < end && *text != '\n')
+		++text;
+	if (text < end)
+		++text;
+}
+
+/*
+ * ParseInt()
+ * Reads a whole number, with an optional sign.
+ * @param text Where to read from, moved past the number.
+ * @param end The end of the text.
+ * @param value Set to the number read.
+ * @return True if there was a number to read.
+ */
+static bool ParseInt(const char*& text, const char* end, long long& value)
+{
+	bool negative = (text < end && *text == '-');
+	if (text < end && (*text == '-' || *text == '+'))
+		++text;
+
+	const char* start = text;
+	value = 0;
+	while (text < end && *text >= '0' && *text <= '9')
+		value = (value * 10) + (*text++ - '0');
+
+	if (negative)
+		value = -value;
+	return text != start;
+}
+
+/*
+ * ParseFloat()
+ * Reads a decimal number such as -1.25 or 3e-4. Up to 19 significant digits are gathered into an integer
+ * and scaled by a power of ten once at the end, which is far quicker than going through a stream or strtof.
+ * @param text Where to read from, moved past the number.
+ * @param end The end of the text.
+ * @param value Set to the number read.
+ * @return True if there was a number to read.
+ */
+static bool ParseFloat(const char*& text, const char* end, float& value)
+{
+	bool negative = (text < end && *text == '-');
+	if (text < end && (*text == '-' || *text == '+'))
+		++text;
+
+	unsigned long long mantissa = 0;
+	int digits = 0;
+	int exponent = 0;
+	bool anyDigits = false;
+
+	for (; text < end && *text >= '0' && *text <= '9'; ++text, anyDigits = true)
+	{
+		if (digits < 19)
+		{
+			mantissa = (mantissa * 10) + (*text - '0');
+			digits += (mantissa != 0) ? 1 : 0;
+		}
+		else
+			++exponent;
+	}
+
+	if (text < end && *text == '.')
+	{
+		for (++text; text < end && *text >= '0' && *text <= '9'; ++text, anyDigits = true)
+		{
+			if (digits < 19)
+			{
+				mantissa = (mantissa * 10) + (*text - '0');
+				digits += (mantissa != 0) ? 1 : 0;
+				--exponent;
+			}
+		}
+	}
+
+	if (!anyDigits)
+		return false;
+
+	if (text < end && (*text == 'e' || *text == 'E'))
+	{
+		const char* exponentStart = text++;
+		long long written = 0;
+		if (ParseInt(text, end, written))
+			exponent += (written > 400) ? 400 : ((written < -400) ? -400 : (int)written);
+		else
+			text = exponentStart;
+	}
+
+	double result = (double)mantissa;
+	for (; exponent > 22; exponent -= 22)
+		result *= POWERS_OF_TEN[22];
+	for (; exponent < -22; exponent += 22)
+		result /= POWERS_OF_TEN[22];
+	result = (exponent < 0) ? result / POWERS_OF_TEN[-exponent] : result * POWERS_OF_TEN[exponent];
+
+	value = (float)(negative ? -result : result);
+	return true;
+}
+
+/*
+ * SourceStamp()
+ * Gets what a cache needs to remember about its source file to notice when it changes.
+ * @param filename The path to the file.
+ * @param size Set to the size of the file in bytes.
+ * @param time Set to when the file was last modified.
+ * @return True if the file exists.
+ */
+static bool SourceStamp(const std::string& filename, long long& size, long long& time)
+{
+	struct stat status;
+	if (stat(filename.c_str(), &status) != 0)
+		return false;
+
+	size = (long long)status.st_size;
+	time = (long long)status.st_mtime;
+	return true;
+}
+
+/*
+ * CacheFilename()
+ * @param filename The path to an OBJ file.
+ * @return The path to its .meshbin cache, which sits next to it.
+ */
+static std::string CacheFilename(const std::string& filename)
 {
-	std::ifstream f(filename);
-	if (!f.is_open())
+	size_t dot = filename.find_last_of('.');
+	size_t slash = filename.find_last_of("/\\");
+	if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+		return filename + ".meshbin";
+	return filename.substr(0, dot) + ".meshbin";
+}
+
+/*
+ * LoadFromObjFile()
+ * Loads the vertices and faces of a Wavefront OBJ file, replacing whatever the mesh held.
+ * Faces may have any number of points and use the v, v/vt, v//vn or v/vt/vn forms, with negative indices counting back from the last vertex.
+ * Polygons are split into a fan of triangles. Texture coordinates are kept, but normals are skipped - vertex normals are worked out from the faces instead.
+ * The first load writes a .meshbin cache next to the file, which later loads read instead for as long as the file is unchanged.
+ * @param filename The path to the file.
+ * @param useCache Whether to read and write the cache, or always parse the OBJ file.
+ * @return True if the file was loaded, false if it couldn't be opened or a face refers to a vertex that doesn't exist.
+ */
+bool Engine::Graphics::Mesh::LoadFromObjFile(const std::string& filename, const bool& useCache)
+{
+	long long sourceSize = 0;
+	long long sourceTime = 0;
+	if (!SourceStamp(filename, sourceSize, sourceTime))
+		return false;
+
+	std::string cacheFilename = CacheFilename(filename);
+	if (useCache && LoadCache(cacheFilename, sourceSize, sourceTime))
+		return true;
+
+	MappedFile file;
+	if (!file.Open(filename) || !ParseObj(file.Data(), file.Size()))
 		return false;
 
-	std::vector<Physics::FVector3> verts;
+	ComputeBounds();
+	ComputeNormals();
 
-	while (!f.eof())
+	if (useCache)
+		SaveCache(cacheFilename, sourceSize, sourceTime);
+	return true;
+}
+
+/*
+ * HasTexCoords()
+ * @param text The contents of an OBJ file.
+ * @param end The end of the text.
+ * @return True if the file has any vt lines.
+ */
+static bool HasTexCoords(const char* text, const char* end)
+{
+	while (text < end)
 	{
-		char line[128];
-		f.getline(line, 128);
+		SkipSpaces(text, end);
+		if (end - text >= 3 && text[0] == 'v' && text[1] == 't' && (text[2] == ' ' || text[2] == '\t'))
+			return true;
+		SkipLine(text, end);
+	}
+	return false;
+}
+
+/*
+ * ParseObj()
+ * Reads the vertices and faces out of the text of an OBJ file, in place.
+ * If the file has texture coordinates, a point can have a different one on each face it is part of, so every pairing of
+ * position and texture coordinate the faces use becomes a vertex of its own. Otherwise the file's vertices are used as they are.
+ * @param text The contents of the file, which doesn't need to be null terminated.
+ * @param length The length of the text.
+ * @return True if every face only refers to vertices and texture coordinates that exist.
+ */
+bool Engine::Graphics::Mesh::ParseObj(const char* text, const size_t& length)
+{
+	vertexX.clear();
+	vertexY.clear();
+	vertexZ.clear();
+	texU.clear();
+	texV.clear();
+	indices.clear();
 
-		std::strstream ss;
-		ss << line;
+	const char* end = text + length;
+	bool textured = HasTexCoords(text, end);
+
+	// The file's own positions and texture coordinates, which faces refer to
+	std::vector<float> positionX, positionY, positionZ;
+	std::vector<float> coordU, coordV;
+
+	// The vertex made for each pairing of position and texture coordinate, keyed by both indices
+	std::unordered_map<unsigned long long, unsigned int> corners;
+
+	while (text < end)
+	{
+		SkipSpaces(text, end);
+		if (end - text < 2)
+		{
+			SkipLine(text, end);
+			continue;
+		}
 
-		char junk;
+		if (text[0] == 'v' && text[1] == 't' && end - text >= 3 && (text[2] == ' ' || text[2] == '\t'))
+		{
+			float u = 0.0f, v = 0.0f;
+			text += 3;
+			SkipSpaces(text, end);
+			ParseFloat(text, end, u);
+			SkipSpaces(text, end);
+			ParseFloat(text, end, v);
 
-		if (line[0] == 'v')
+			// OBJ files put v = 0 at the bottom of the image, sprites put row 0 at the top
+			coordU.push_back(u);
+			coordV.push_back(1.0f - v);
+		}
+		else if (text[1] != ' ' && text[1] != '\t')
 		{
-			Physics::FVector3 v;
-			ss >> junk >> v.x >> v.y >> v.z;
-			verts.push_back(v);
+			SkipLine(text, end);
+			continue;
+		}
+		else if (text[0] == 'v')
+		{
+			float x = 0.0f, y = 0.0f, z = 0.0f;
+			text += 2;
+			SkipSpaces(text, end);
+			ParseFloat(text, end, x);
+			SkipSpaces(text, end);
+			ParseFloat(text, end, y);
+			SkipSpaces(text, end);
+			ParseFloat(text, end, z);
+
+			positionX.push_back(x);
+			positionY.push_back(y);
+			positionZ.push_back(z);
 		}
-		else if (line[0] == 'f')
+		else if (text[0] == 'f')
 		{
-			int f[3];
-			ss >> junk >> f[0] >> f[1] >> f[2];
-			tris.push_back(Triangle(verts[f[0] - 1], verts[f[1] - 1], verts[f[2] - 1]));
+			long long positionCount = (long long)positionX.size();
+			long long coordCount = (long long)coordU.size();
+			unsigned int first = 0;
+			unsigned int previous = 0;
+			int points = 0;
+
+			text += 2;
+			SkipSpaces(text, end);
+			for (long long index = 0; ParseInt(text, end, index); ++points)
+			{
+				// Negative indices count back from the most recent vertex
+				index = (index < 0) ? positionCount + index : index - 1;
+				if (index < 0 || index >= positionCount)
+					return false;
+
+				long long coord = -1;
+				if (text < end && *text == '/')
+				{
+					++text;
+					if (ParseInt(text, end, coord))
+					{
+						coord = (coord < 0) ? coordCount + coord : coord - 1;
+						if (coord < 0 || coord >= coordCount)
+							return false;
+					}
+					else
+						coord = -1;
+				}
+
+				// Normals aren't used
+				while (text < end && *text != ' ' && *text != '\t' && *text != '\r' && *text != '\n')
+					++text;
+				SkipSpaces(text, end);
+
+				unsigned int current = (unsigned int)index;
+				if (textured)
+				{
+					unsigned long long key = ((unsigned long long)index << 32) | (unsigned long long)(coord + 1);
+					std::unordered_map<unsigned long long, unsigned int>::iterator corner = corners.find(key);
+					if (corner == corners.end())
+					{
+						current = (unsigned int)vertexX.size();
+						corners.emplace(key, current);
+						vertexX.push_back(positionX[(size_t)index]);
+						vertexY.push_back(positionY[(size_t)index]);
+						vertexZ.push_back(positionZ[(size_t)index]);
+						texU.push_back((coord >= 0) ? coordU[(size_t)coord] : 0.0f);
+						texV.push_back((coord >= 0) ? coordV[(size_t)coord] : 0.0f);
+					}
+					else
+						current = corner->second;
+				}
+
+				if (points == 0)
+					first = current;
+				else if (points >= 2)
+				{
+					indices.push_back(first);
+					indices.push_back(previous);
+					indices.push_back(current);
+				}
+				previous = current;
+			}
 		}
+
+		SkipLine(text, end);
+	}
+
+	if (!textured)
+	{
+		vertexX.swap(positionX);
+		vertexY.swap(positionY);
+		vertexZ.swap(positionZ);
+	}
+
+	return true;
+}
+
+/*
+ * LoadCache()
+ * Reads the mesh from a .meshbin cache, if it was made from the source file as it is now.
+ * @param filename The path to the cache.
+ * @param sourceSize The size of the source file the cache must have been made from.
+ * @param sourceTime The modification time of the source file the cache must have been made from.
+ * @return True if the mesh was loaded from the cache, false if it doesn't exist or is out of date.
+ */
+bool Engine::Graphics::Mesh::LoadCache(const std::string& filename, const long long& sourceSize, const long long& sourceTime)
+{
+	MappedFile file;
+	if (!file.Open(filename) || file.Size() < sizeof(MeshCacheHeader))
+		return false;
+
+	MeshCacheHeader header;
+	memcpy(&header, file.Data(), sizeof(MeshCacheHeader));
+	if (memcmp(header.magic, MESH_CACHE_MAGIC, sizeof(MESH_CACHE_MAGIC)) != 0 || header.version != MESH_CACHE_VERSION ||
+		header.sourceSize != sourceSize || header.sourceTime != sourceTime)
+		return false;
+
+	size_t vertexCount = header.vertexCount;
+	size_t indexCount = header.indexCount;
+	if (header.texCoordCount != 0 && header.texCoordCount != vertexCount)
+		return false;
+
+	size_t arrayCount = (header.texCoordCount != 0) ? 8 : 6;
+	if (file.Size() != sizeof(MeshCacheHeader) + (sizeof(float) * vertexCount * arrayCount) + (sizeof(unsigned int) * indexCount))
+		return false;
+
+	const float* vertices = reinterpret_cast<const float*>(file.Data() + sizeof(MeshCacheHeader));
+	const unsigned int* cachedIndices = reinterpret_cast<const unsigned int*>(vertices + (vertexCount * arrayCount));
+	for (size_t i = 0; i < indexCount; ++i)
+		if (cachedIndices[i] >= vertexCount)
+			return false;
+
+	vertexX.assign(vertices, vertices + vertexCount);
+	vertexY.assign(vertices + vertexCount, vertices + (vertexCount * 2));
+	vertexZ.assign(vertices + (vertexCount * 2), vertices + (vertexCount * 3));
+	normalX.assign(vertices + (vertexCount * 3), vertices + (vertexCount * 4));
+	normalY.assign(vertices + (vertexCount * 4), vertices + (vertexCount * 5));
+	normalZ.assign(vertices + (vertexCount * 5), vertices + (vertexCount * 6));
+	if (header.texCoordCount != 0)
+	{
+		texU.assign(vertices + (vertexCount * 6), vertices + (vertexCount * 7));
+		texV.assign(vertices + (vertexCount * 7), vertices + (vertexCount * 8));
 	}
-	f.close();
+	else
+	{
+		texU.clear();
+		texV.clear();
+	}
+	indices.assign(cachedIndices, cachedIndices + indexCount);
+
+	boundsCentre = Physics::FVector3(header.boundsCentre[0], header.boundsCentre[1], header.boundsCentre[2]);
+	boundsRadius = header.boundsRadius;
 	return true;
+}
+
+/*
+ * SaveCache()
+ * Writes the mesh to a .meshbin cache. Failing to write it isn't an error, the OBJ file is just parsed again next time.
+ * @param filename The path to the cache.
+ * @param sourceSize The size of the source file the mesh was loaded from.
+ * @param sourceTime The modification time of the source file the mesh was loaded from.
+ */
+void Engine::Graphics::Mesh::SaveCache(const std::string& filename, const long long& sourceSize, const long long& sourceTime) const
+{
+	FILE* file = nullptr;
+#ifdef _WIN32
+	fopen_s(&file, filename.c_str(), "wb");
+#else
+	file = fopen(filename.c_str(), "wb");
+#endif
+	if (file == nullptr)
+		return;
+
+	MeshCacheHeader header;
+	memset(&header, 0, sizeof(MeshCacheHeader));
+	memcpy(header.magic, MESH_CACHE_MAGIC, sizeof(MESH_CACHE_MAGIC));
+	header.version = MESH_CACHE_VERSION;
+	header.sourceSize = sourceSize;
+	header.sourceTime = sourceTime;
+	header.vertexCount = (uint32_t)vertexX.size();
+	header.indexCount = (uint32_t)indices.size();
+	header.texCoordCount = (uint32_t)texU.size();
+	header.boundsCentre[0] = boundsCentre.x;
+	header.boundsCentre[1] = boundsCentre.y;
+	header.boundsCentre[2] = boundsCentre.z;
+	header.boundsRadius = boundsRadius;
+
+	bool written = fwrite(&header, sizeof(MeshCacheHeader), 1, file) == 1;
+
+	// Untextured meshes have no texture coordinates, and fwrite() must not be handed the null data() of an empty array
+	written = written && (vertexX.empty() || fwrite(vertexX.data(), sizeof(float), vertexX.size(), file) == vertexX.size());
+	written = written && (vertexY.empty() || fwrite(vertexY.data(), sizeof(float), vertexY.size(), file) == vertexY.size());
+	written = written && (vertexZ.empty() || fwrite(vertexZ.data(), sizeof(float), vertexZ.size(), file) == vertexZ.size());
+	written = written && (normalX.empty() || fwrite(normalX.data(), sizeof(float), normalX.size(), file) == normalX.size());
+	written = written && (normalY.empty() || fwrite(normalY.data(), sizeof(float), normalY.size(), file) == normalY.size());
+	written = written && (normalZ.empty() || fwrite(normalZ.data(), sizeof(float), normalZ.size(), file) == normalZ.size());
+	written = written && (texU.empty() || fwrite(texU.data(), sizeof(float), texU.size(), file) == texU.size());
+	written = written && (texV.empty() || fwrite(texV.data(), sizeof(float), texV.size(), file) == texV.size());
+	written = written && (indices.empty() || fwrite(indices.data(), sizeof(unsigned int), indices.size(), file) == indices.size());
+	written = (fclose(file) == 0) && written;
+
+	// A half written cache would only be rejected for its size, but there's no reason to leave it lying around
+	if (!written)
+		remove(filename.c_str());
+}
+
+/*
+ * ComputeBounds()
+ * Fits the bounding sphere around the vertices, centred on the middle of their bounding box.
+ * Must be called again if the vertices are changed.
+ */
+void Engine::Graphics::Mesh::ComputeBounds()
+{
+	if (vertexX.empty())
+	{
+		boundsCentre = Physics::FVector3();
+		boundsRadius = 0.0f;
+		return;
+	}
+
+	Physics::FVector3 min(vertexX[0], vertexY[0], vertexZ[0]);
+	Physics::FVector3 max = min;
+	for (size_t i = 1; i < vertexX.size(); ++i)
+	{
+		min = Physics::FVector3(fminf(min.x, vertexX[i]), fminf(min.y, vertexY[i]), fminf(min.z, vertexZ[i]));
+		max = Physics::FVector3(fmaxf(max.x, vertexX[i]), fmaxf(max.y, vertexY[i]), fmaxf(max.z, vertexZ[i]));
+	}
+
+	boundsCentre = (min + max) * 0.5f;
+
+	float radiusSquared = 0.0f;
+	for (size_t i = 0; i < vertexX.size(); ++i)
+	{
+		Physics::FVector3 offset = Physics::FVector3(vertexX[i], vertexY[i], vertexZ[i]) - boundsCentre;
+		radiusSquared = fmaxf(radiusSquared, offset.DotProduct(offset));
+	}
+	boundsRadius = sqrtf(radiusSquared);
+}
+
+/*
+ * ComputeNormals()
+ * Works out a normal for every vertex by adding up the normals of the faces around it, each as long as twice the face's area,
+ * so big faces count for more, and normalising the sum. Faces wind the same way as the back face culling expects.
+ * Must be called again if the vertices or indices are changed.
+ */
+void Engine::Graphics::Mesh::ComputeNormals()
+{
+	normalX.assign(vertexX.size(), 0.0f);
+	normalY.assign(vertexX.size(), 0.0f);
+	normalZ.assign(vertexX.size(), 0.0f);
+
+	for (size_t t = 0; t < TriangleCount(); ++t)
+	{
+		const unsigned int* triangle = &indices[t * 3];
+		Physics::FVector3 a(vertexX[triangle[0]], vertexY[triangle[0]], vertexZ[triangle[0]]);
+		Physics::FVector3 b(vertexX[triangle[1]], vertexY[triangle[1]], vertexZ[triangle[1]]);
+		Physics::FVector3 c(vertexX[triangle[2]], vertexY[triangle[2]], vertexZ[triangle[2]]);
+		Physics::FVector3 normal = (b - a).CrossProduct(c - a);
+
+		for (int i = 0; i < 3; ++i)
+		{
+			normalX[triangle[i]] += normal.x;
+			normalY[triangle[i]] += normal.y;
+			normalZ[triangle[i]] += normal.z;
+		}
+	}
+
+	for (size_t i = 0; i < normalX.size(); ++i)
+	{
+		float length = sqrtf((normalX[i] * normalX[i]) + (normalY[i] * normalY[i]) + (normalZ[i] * normalZ[i]));
+		if (length > 0.0f)
+		{
+			normalX[i] /= length;
+			normalY[i] /= length;
+			normalZ[i] /= length;
+		}
+	}
+}
+
+// ACCESS ######################################################################################################################################################
+
+/*
+ * VertexCount()
+ * @return The number of unique vertices in the mesh.
+ */
+size_t Engine::Graphics::Mesh::VertexCount() const { return vertexX.size(); }
+
+/*
+ * TriangleCount()
+ * @return The number of triangles in the mesh.
+ */
+size_t Engine::Graphics::Mesh::TriangleCount() const { return indices.size() / 3; }
+
+/*
+ * Textured()
+ * @return True if the mesh has a texture coordinate for every vertex.
+ */
+bool Engine::Graphics::Mesh::Textured() const { return !texU.empty() && texU.size() == vertexX.size(); }
+
+/*
+ * GetTriangle()
+ * Builds a standalone copy of one of the mesh's triangles.
+ * @param index The triangle to get.
+ * @return The triangle with its vertices, and texture coordinates if it has them, copied out of the mesh.
+ */
+Engine::Graphics::Triangle Engine::Graphics::Mesh::GetTriangle(const size_t& index) const
+{
+	const unsigned int* triangle = &indices[index * 3];
+	Triangle out(Physics::FVector3(vertexX[triangle[0]], vertexY[triangle[0]], vertexZ[triangle[0]]),
+				 Physics::FVector3(vertexX[triangle[1]], vertexY[triangle[1]], vertexZ[triangle[1]]),
+				 Physics::FVector3(vertexX[triangle[2]], vertexY[triangle[2]], vertexZ[triangle[2]]));
+
+	if (Textured())
+	{
+		for (int i = 0; i < 3; ++i)
+		{
+			out.texU[i] = texU[triangle[i]];
+			out.texV[i] = texV[triangle[i]];
+		}
+	}
+	return out;
+}
+
+// TRANSFORM ###################################################################################################################################################
+
+/*
+ * Transform()
+ * Takes every unique vertex into world space and then clip space in one pass, keeping both.
+ * Uses AVX or SSE to transform 8 or 4 vertices at once where available.
+ * @param world The world matrix of the mesh.
+ * @param viewProjection The view matrix of the camera multiplied by its projection matrix.
+ * @param arena The arena to allocate the results from.
+ * @return The transformed vertices.
+ */
+Engine::Graphics::TransformedMesh Engine::Graphics::Mesh::Transform(const Physics::Matrix4x4& world, const Physics::Matrix4x4& viewProjection, FrameArena& arena) const
+{
+	TransformedMesh out;
+	TransformInstances(&world, 1, viewProjection, arena, &out);
+	return out;
+}
+
+/*
+ * TransformInstances()
+ * Transforms the mesh for several instances at once, the same as calling Transform() for each of them but reading
+ * each batch of vertices only once and sending it through every instance's world matrix while it is still in registers.
+ * @param worlds The world matrix of each instance.
+ * @param instanceCount The number of instances.
+ * @param viewProjection The view matrix of the camera multiplied by its projection matrix.
+ * @param arena The arena to allocate the results from.
+ * @param out Set to the transformed vertices of each instance. Must have room for instanceCount results.
+ */
+void Engine::Graphics::Mesh::TransformInstances(const Physics::Matrix4x4* worlds, const size_t& instanceCount, const Physics::Matrix4x4& viewProjection, FrameArena& arena, TransformedMesh* out) const
+{
+	size_t vertexCount = vertexX.size();
+	for (size_t k = 0; k < instanceCount; ++k)
+	{
+		out[k].vertexCount = vertexCount;
+		float** arrays[7] = { &out[k].worldX, &out[k].worldY, &out[k].worldZ, &out[k].clipX, &out[k].clipY, &out[k].clipZ, &out[k].clipW };
+		for (float** array : arrays)
+			*array = static_cast<float*>(arena.Allocate(sizeof(float) * vertexCount, 32));
+	}
+
+	size_t i = 0;
+
+#if defined(MESH_SIMD_AVX) || defined(MESH_SIMD_SSE)
+	MatrixLanes* worldLanes = static_cast<MatrixLanes*>(arena.Allocate(sizeof(MatrixLanes) * instanceCount, alignof(MatrixLanes)));
+	for (size_t k = 0; k < instanceCount; ++k)
+		new (&worldLanes[k]) MatrixLanes(worlds[k]);
+	MatrixLanes viewProjectionLanes(viewProjection);
+
+	size_t simdCount = vertexCount - (vertexCount % LANE_COUNT);
+
+	// A few instances at a time, as writing every instance's arrays at once would have far more streams than the cache can keep track of
+	for (size_t first = 0; first < instanceCount; first += TRANSFORM_INSTANCE_BLOCK)
+	{
+		size_t last = (first + TRANSFORM_INSTANCE_BLOCK < instanceCount) ? first + TRANSFORM_INSTANCE_BLOCK : instanceCount;
+
+		for (i = 0; i < simdCount; i += LANE_COUNT)
+		{
+			Lanes modelX = LoadLanes(&vertexX[i]);
+			Lanes modelY = LoadLanes(&vertexY[i]);
+			Lanes modelZ = LoadLanes(&vertexZ[i]);
+
+			for (size_t k = first; k < last; ++k)
+			{
+				Lanes x = modelX, y = modelY, z = modelZ;
+				TransformLanes(x, y, z, worldLanes[k]);
+				StoreLanes(&out[k].worldX[i], x);
+				StoreLanes(&out[k].worldY[i], y);
+				StoreLanes(&out[k].worldZ[i], z);
+
+				Lanes clipX, clipY, clipZ, clipW;
+				ClipLanes(x, y, z, viewProjectionLanes, clipX, clipY, clipZ, clipW);
+				StoreLanes(&out[k].clipX[i], clipX);
+				StoreLanes(&out[k].clipY[i], clipY);
+				StoreLanes(&out[k].clipZ[i], clipZ);
+				StoreLanes(&out[k].clipW[i], clipW);
+			}
+		}
+	}
+	i = simdCount;
+#endif
+
+	// Whatever doesn't fill a whole batch
+	const float (&m)[4][4] = viewProjection.matrix;
+	for (; i < vertexCount; ++i)
+	{
+		for (size_t k = 0; k < instanceCount; ++k)
+		{
+			Physics::FVector3 point = Physics::FVector3(vertexX[i], vertexY[i], vertexZ[i]) * worlds[k];
+			out[k].worldX[i] = point.x;
+			out[k].worldY[i] = point.y;
+			out[k].worldZ[i] = point.z;
+
+			out[k].clipX[i] = (point.x * m[0][0]) + (point.y * m[1][0]) + (point.z * m[2][0]) + m[3][0];
+			out[k].clipY[i] = (point.x * m[0][1]) + (point.y * m[1][1]) + (point.z * m[2][1]) + m[3][1];
+			out[k].clipZ[i] = (point.x * m[0][2]) + (point.y * m[1][2]) + (point.z * m[2][2]) + m[3][2];
+			out[k].clipW[i] = (point.x * m[0][3]) + (point.y * m[1][3]) + (point.z * m[2][3]) + m[3][3];
+		}
+	}
 }
\ No newline at end of file
@@ -1,17 +1,74 @@
 #pragma once
-#include <fstream>
-#include <strstream>
+#include <string>
 #include <vector>
 
+#include "FrameArena.h"
 #include "FVector3.h"
+#include "Matrix4x4.h"
 #include "Triangle.h"
 
 namespace Engine { namespace Graphics {
+	/**
+	 * TransformedMesh
+	 * The vertices of a mesh after Mesh::Transform(), one array per component, in the same order as the mesh's vertices.
+	 * Clip space positions haven't been divided by w yet, so they can be clipped before anything behind the camera is projected.
+	 * The arrays are allocated from a FrameArena so only last until the end of the tick.
+	 */
+	struct TransformedMesh
+	{
+		size_t vertexCount;
+		float* worldX;
+		float* worldY;
+		float* worldZ;
+		float* clipX;
+		float* clipY;
+		float* clipZ;
+		float* clipW;
+	};
+
+	/**
+	 * Mesh
+	 * An indexed triangle mesh. Each unique vertex is stored once, one array per component,
+	 * and every triangle is three indices into them, so shared vertices are only transformed once.
+	 */
 	class Mesh
 	{
+	private:
+		bool ParseObj(const char* text, const size_t& length);
+		bool LoadCache(const std::string& filename, const long long& sourceSize, const long long& sourceTime);
+		void SaveCache(const std::string& filename, const long long& sourceSize, const long long& sourceTime) const;
+
 	public:
-		std::vector<Triangle> tris;
+		std::vector<float> vertexX;
+		std::vector<float> vertexY;
+		std::vector<float> vertexZ;
+		std::vector<unsigned int> indices;
+
+		// Unit normal at each vertex, the average of the faces around it weighted by their area
+		std::vector<float> normalX;
+		std::vector<float> normalY;
+		std::vector<float> normalZ;
+
+		// Where each vertex sits on the mesh's texture, with 0, 0 the top left and 1, 1 the bottom right. Empty if the mesh isn't textured
+		std::vector<float> texU;
+		std::vector<float> texV;
+
+		// Bounding sphere around every vertex, in model space
+		Physics::FVector3 boundsCentre;
+		float boundsRadius;
+
+		Mesh(void);
+
+		bool LoadFromObjFile(const std::string& filename, const bool& useCache = true);
+		void ComputeBounds(void);
+		void ComputeNormals(void);
+
+		size_t VertexCount(void) const;
+		size_t TriangleCount(void) const;
+		bool Textured(void) const;
+		Triangle GetTriangle(const size_t& index) const;
 
-		bool LoadFromObjFile(std::string filename);
+		TransformedMesh Transform(const Physics::Matrix4x4& world, const Physics::Matrix4x4& viewProjection, FrameArena& arena) const;
+		void TransformInstances(const Physics::Matrix4x4* worlds, const size_t& instanceCount, const Physics::Matrix4x4& viewProjection, FrameArena& arena, TransformedMesh* out) const;
 	};
 }}
\ No newline at end of file
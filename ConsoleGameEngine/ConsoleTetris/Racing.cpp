@@ -1,3 +1,5 @@
+#include <cwchar>
+
 #include "Racing.h"
 
 
@@ -165,17 +167,28 @@ void Racing::Draw()
 	}
 
 
-	engine->DrawString(0, 0, L"Distance: " + std::to_wstring(distance));
-	engine->DrawString(0, 1, L"Target Curve: " + std::to_wstring(curve));
-	engine->DrawString(0, 2, L"Player Curve: " + std::to_wstring(playerCurve));
-	engine->DrawString(0, 3, L"Player Speed: " + std::to_wstring(speed));
-	engine->DrawString(0, 4, L"Track Curve: " + std::to_wstring(trackCurve));
-	engine->DrawString(0, 6, L"Lap Time: " + Time::Instance().ConvertSecondsToTime(currentLapTime));
+	// Formatted on the stack rather than joined from std::wstrings, which allocated every frame
+	wchar_t text[64], time[32];
+	swprintf(text, 64, L"Distance: %f", distance);
+	engine->DrawString(0, 0, text);
+	swprintf(text, 64, L"Target Curve: %f", curve);
+	engine->DrawString(0, 1, text);
+	swprintf(text, 64, L"Player Curve: %f", playerCurve);
+	engine->DrawString(0, 2, text);
+	swprintf(text, 64, L"Player Speed: %f", speed);
+	engine->DrawString(0, 3, text);
+	swprintf(text, 64, L"Track Curve: %f", trackCurve);
+	engine->DrawString(0, 4, text);
+	Time::ConvertSecondsToTime(currentLapTime, time, 32);
+	swprintf(text, 64, L"Lap Time: %ls", time);
+	engine->DrawString(0, 6, text);
 
 	int i = 0;
 	for (float lapTime : lapTimes)
 	{
-		engine->DrawString(0, 8 + i, L"Time: " + Time::Instance().ConvertSecondsToTime(lapTime));
+		Time::ConvertSecondsToTime(lapTime, time, 32);
+		swprintf(text, 64, L"Time: %ls", time);
+		engine->DrawString(0, 8 + i, text);
 		++i;
 	}
 }
@@ -0,0 +1,44 @@
+#pragma once
+#include "CharInfo.h"
+
+namespace Engine { namespace Graphics {
+	/**
+	 * DirtySpan
+	 * A run of characters on a single row of the screen buffer that has changed since the last frame.
+	 */
+	struct DirtySpan
+	{
+		short row;
+		short minX;
+		short maxX;
+	};
+
+	/**
+	 * FrameStats
+	 * Timings and counts for the frame being drawn, shown on the top bar.
+	 */
+	struct FrameStats
+	{
+		float fps;
+		float runTime;
+		float renderTime;
+		int changedCells;
+		int allocations;
+	};
+
+	/**
+	 * RenderBackend
+	 * The interface for anything the screen buffer can be drawn to.
+	 * Classes implemented from this class must override:
+	 *		- SetupWindow() to size the output to the screen buffer.
+	 *		- Draw() to output the changed spans of the screen buffer.
+	 */
+	class RenderBackend
+	{
+	public:
+		virtual ~RenderBackend(void) { }
+
+		virtual void SetupWindow(const int& width, const int& height, const int& fontWidth, const int& fontHeight) = 0;
+		virtual void Draw(const wchar_t* title, const CharInfo* characterArray, const DirtySpan* spans, const int& spanCount, const FrameStats& stats) = 0;
+	};
+} }
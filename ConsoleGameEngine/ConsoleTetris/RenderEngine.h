@@ -1,33 +1,29 @@
 #pragma once
-#include <iostream>
-#include <Windows.h>
-
+#include "RenderBackend.h"
 #include "Singleton.h"
-#include "Time.h"
 
 namespace Engine { namespace Graphics {
 	/**
 	 * RenderEngine
-	 * Handles drawing to the console.
+	 * Handles drawing to the screen through the backend for the current platform.
+	 * Defaults to the Windows console on Windows and a VT terminal everywhere else.
 	 */
 	class RenderEngine : public Singleton<RenderEngine>
 	{
 		friend class Singleton<RenderEngine>;
 
 	private:
-		HANDLE console;
-		DWORD bytesWritten;
-		SMALL_RECT windowRect;
-
-		int screenWidth;
-		int screenHeight;
+		RenderBackend* backend;
 
-		RenderEngine(void) { }
+		RenderEngine(void);
 		
 	public:
 		~RenderEngine(void);
 
+		RenderBackend* Backend(void) const;
+		void SetBackend(RenderBackend* newBackend);
+
 		void SetupWindow(const int& width, const int& height, const int& fontWidth = 8, const int& fontHeight = 16);
-		void Draw(const wchar_t* title, const CHAR_INFO* characterArray, const float& runTime, const float& renderTime);
+		void Draw(const wchar_t* title, const CharInfo* characterArray, const DirtySpan* spans, const int& spanCount, const FrameStats& stats);
 	};
-} }
\ No newline at end of file
+} }
@@ -0,0 +1,109 @@
+#include "Scene.h"
+
+/**
+ * Constructor
+ */
+Engine::Graphics::Scene::Scene() { }
+
+/**
+ * Destructor
+ */
+Engine::Graphics::Scene::~Scene()
+{
+	for (MeshBatch& batch : batches)
+	{
+		delete batch.mesh;
+		delete batch.texture;
+	}
+}
+
+/*
+ * AddMesh()
+ * Adds a mesh for instances to be placed with. The scene takes ownership of it, and its texture, and deletes them when it is destroyed.
+ * @param mesh The mesh to add.
+ * @param texture The texture to draw the mesh with, or nullptr to light it instead. Only used if the mesh has texture coordinates.
+ * @return The ID of the mesh.
+ */
+int Engine::Graphics::Scene::AddMesh(Mesh* mesh, Sprite* texture)
+{
+	MeshBatch batch;
+	batch.mesh = mesh;
+	batch.texture = texture;
+	batches.push_back(batch);
+	return (int)batches.size() - 1;
+}
+
+/*
+ * AddInstance()
+ * Places a mesh in the world.
+ * @param meshID The ID of the mesh to place.
+ * @param world The world matrix of the instance.
+ * @param colour The colour to light the instance with.
+ * @return The index of the instance within its mesh's batch.
+ */
+size_t Engine::Graphics::Scene::AddInstance(const int& meshID, const Physics::Matrix4x4& world, const short& colour)
+{
+	SceneInstance instance;
+	instance.world = world;
+	instance.colour = colour;
+	instance.visible = true;
+
+	std::vector<SceneInstance>& instances = batches[meshID].instances;
+	instances.push_back(instance);
+	return instances.size() - 1;
+}
+
+/*
+ * ClearInstances()
+ * Removes every instance, keeping the meshes.
+ */
+void Engine::Graphics::Scene::ClearInstances()
+{
+	for (MeshBatch& batch : batches)
+		batch.instances.clear();
+}
+
+/*
+ * Instance()
+ * @param meshID The ID of the instance's mesh.
+ * @param index The index of the instance within its mesh's batch.
+ * @return The instance, to move or hide.
+ */
+Engine::Graphics::SceneInstance& Engine::Graphics::Scene::Instance(const int& meshID, const size_t& index) { return batches[meshID].instances[index]; }
+
+/*
+ * BatchCount()
+ * @return The number of meshes in the scene.
+ */
+size_t Engine::Graphics::Scene::BatchCount() const { return batches.size(); }
+
+/*
+ * Batch()
+ * @param index The ID of the mesh.
+ * @return The mesh and all of its instances.
+ */
+const Engine::Graphics::MeshBatch& Engine::Graphics::Scene::Batch(const size_t& index) const { return batches[index]; }
+
+/*
+ * InstanceCount()
+ * @return The number of instances of every mesh.
+ */
+size_t Engine::Graphics::Scene::InstanceCount() const
+{
+	size_t count = 0;
+	for (const MeshBatch& batch : batches)
+		count += batch.instances.size();
+	return count;
+}
+
+/*
+ * TriangleCount()
+ * @return The number of triangles in every instance of every mesh, before any are culled.
+ */
+size_t Engine::Graphics::Scene::TriangleCount() const
+{
+	size_t count = 0;
+	for (const MeshBatch& batch : batches)
+		count += batch.mesh->TriangleCount() * batch.instances.size();
+	return count;
+}
\ No newline at end of file
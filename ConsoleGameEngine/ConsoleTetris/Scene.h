@@ -0,0 +1,59 @@
+#pragma once
+#include <vector>
+
+#include "Matrix4x4.h"
+#include "Mesh.h"
+#include "Sprite.h"
+
+namespace Engine { namespace Graphics {
+	/**
+	 * SceneInstance
+	 * One placement of a mesh in the world. Any number of instances can share a mesh without copying its triangles.
+	 */
+	struct SceneInstance
+	{
+		Physics::Matrix4x4 world;
+		short colour;
+		bool visible;
+	};
+
+	/**
+	 * MeshBatch
+	 * A mesh and every instance of it, kept together so all of them can be transformed in one pass over the mesh's vertices.
+	 * Textured meshes are drawn with the texture instead of being lit.
+	 */
+	struct MeshBatch
+	{
+		Mesh* mesh;
+		Sprite* texture;
+		std::vector<SceneInstance> instances;
+	};
+
+	/**
+	 * Scene
+	 * Owns a set of meshes and the instances placing them in the world, grouped into one batch per mesh.
+	 * Meshes are referred to by the ID AddMesh() gives them, and instances by their mesh's ID and their index within its batch.
+	 */
+	class Scene
+	{
+	private:
+		std::vector<MeshBatch> batches;
+
+	public:
+		Scene(void);
+		~Scene(void);
+
+		int AddMesh(Mesh* mesh, Sprite* texture = nullptr);
+		size_t AddInstance(const int& meshID, const Physics::Matrix4x4& world, const short& colour);
+		void ClearInstances(void);
+
+		SceneInstance& Instance(const int& meshID, const size_t& index);
+		size_t BatchCount(void) const;
+		const MeshBatch& Batch(const size_t& index) const;
+		size_t InstanceCount(void) const;
+		size_t TriangleCount(void) const;
+
+		Scene(Scene const&) = delete;
+		void operator=(Scene const&) = delete;
+	};
+}}
\ No newline at end of file
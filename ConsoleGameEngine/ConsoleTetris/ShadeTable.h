@@ -0,0 +1,169 @@
+#pragma once
+#include "Colour.h"
+
+namespace Engine { namespace Graphics {
+	/**
+	 * Shade
+	 * The character and colour attributes that together show one brightness of a colour.
+	 */
+	struct Shade
+	{
+		short character;
+		short colour;
+	};
+
+	// The brightnesses a colour can be shown at, from black to white, and the greys
+	static const int SHADE_STEPS = 19;
+	static const int GREY_SHADE_STEPS = 13;
+
+	// Each step is split into this many levels, so dithering can mix two neighbouring steps in the right amounts
+	static const int SHADE_SUBSTEPS = 16;
+	static const int SHADE_LEVELS = SHADE_STEPS * SHADE_SUBSTEPS;
+
+	/**
+	 * ColourShade()
+	 * Builds one step of a colour's brightness ramp, mixing it with its dark version, black and the greys.
+	 * @param baseColour One of the 16 FG_ colours. Bright colours mix with their dark version, the rest with themselves.
+	 * @param step The brightness, from 0 for black to SHADE_STEPS - 1 for nearly white.
+	 * @return The character and colours that show that brightness.
+	 */
+	constexpr Shade ColourShade(const short& baseColour, const int& step)
+	{
+		short darkColour = (baseColour >= FG_DARK_GREY) ? baseColour - 8 : baseColour;
+
+		switch (step)
+		{
+		case 0: return { PIXEL_SOLID, BG_BLACK | BG_BLACK };
+
+		case 1: return { PIXEL_QUARTER, (short)(BG_BLACK | darkColour) };
+		case 2: return { PIXEL_HALF, (short)(BG_BLACK | darkColour) };
+
+		case 3: return { PIXEL_QUARTER, (short)(BG_BLACK | baseColour) };
+		case 4: return { PIXEL_HALF, (short)(BG_BLACK | baseColour) };
+
+		case 5: return { PIXEL_THREEQUARTER, (short)(BG_BLACK | darkColour) };
+		case 6: return { PIXEL_SOLID, (short)(BG_BLACK | darkColour) };
+		case 7: return { PIXEL_SOLID, (short)(BG_DARK_GREY | darkColour) };
+		case 8: return { PIXEL_SOLID, (short)(BG_GREY | darkColour) };
+		case 9: return { PIXEL_SOLID, (short)(BG_WHITE | darkColour) };
+
+		case 10: return { PIXEL_THREEQUARTER, (short)(BG_BLACK | baseColour) };
+		case 11: return { PIXEL_SOLID, (short)(BG_BLACK | baseColour) };
+		case 12: return { PIXEL_SOLID, (short)(BG_DARK_GREY | baseColour) };
+		case 13: return { PIXEL_SOLID, (short)(BG_GREY | baseColour) };
+		case 14: return { PIXEL_SOLID, (short)(BG_WHITE | baseColour) };
+		case 15: return { PIXEL_THREEQUARTER, (short)(BG_WHITE | baseColour) };
+		case 16: return { PIXEL_HALF, (short)(BG_WHITE | baseColour) };
+		case 17: return { PIXEL_QUARTER, (short)(BG_WHITE | baseColour) };
+
+		case 18: return { PIXEL_QUARTER, BG_WHITE | FG_WHITE };
+
+		default: return { PIXEL_SOLID, BG_BLACK | FG_BLACK };
+		}
+	}
+
+	/**
+	 * GreyShade()
+	 * Builds one step of the grey brightness ramp.
+	 * @param step The brightness, from 0 for nearly black to GREY_SHADE_STEPS - 1 for white.
+	 * @return The character and colours that show that brightness.
+	 */
+	constexpr Shade GreyShade(const int& step)
+	{
+		switch (step)
+		{
+		case 0: return { PIXEL_QUARTER, BG_BLACK | FG_DARK_GREY };
+
+		case 1: return { PIXEL_QUARTER, BG_BLACK | FG_DARK_GREY };
+		case 2: return { PIXEL_HALF, BG_BLACK | FG_DARK_GREY };
+		case 3: return { PIXEL_THREEQUARTER, BG_BLACK | FG_DARK_GREY };
+		case 4: return { PIXEL_SOLID, BG_BLACK | FG_DARK_GREY };
+
+		case 5: return { PIXEL_QUARTER, BG_DARK_GREY | FG_GREY };
+		case 6: return { PIXEL_HALF, BG_DARK_GREY | FG_GREY };
+		case 7: return { PIXEL_THREEQUARTER, BG_DARK_GREY | FG_GREY };
+		case 8: return { PIXEL_SOLID, BG_DARK_GREY | FG_GREY };
+
+		case 9:  return { PIXEL_QUARTER, BG_GREY | FG_WHITE };
+		case 10: return { PIXEL_HALF, BG_GREY | FG_WHITE };
+		case 11: return { PIXEL_THREEQUARTER, BG_GREY | FG_WHITE };
+		case 12: return { PIXEL_SOLID, BG_GREY | FG_WHITE };
+
+		default: return { PIXEL_SOLID, BG_BLACK | FG_BLACK };
+		}
+	}
+
+	/**
+	 * ShadeTable
+	 * Every step of every colour's brightness ramp, worked out by the compiler so shading is a single array read.
+	 */
+	struct ShadeTable
+	{
+		Shade colours[16][SHADE_STEPS];
+		Shade greys[GREY_SHADE_STEPS];
+
+		// Ordered (Bayer) dither thresholds, one per cell of a 4x4 block, spread evenly over a step's levels
+		int dither[4][4];
+	};
+
+	/**
+	 * MakeShadeTable()
+	 * @return The filled in table.
+	 */
+	constexpr ShadeTable MakeShadeTable(void)
+	{
+		ShadeTable table = {};
+		for (int colour = 0; colour < 16; ++colour)
+			for (int step = 0; step < SHADE_STEPS; ++step)
+				table.colours[colour][step] = ColourShade((short)colour, step);
+
+		for (int step = 0; step < GREY_SHADE_STEPS; ++step)
+			table.greys[step] = GreyShade(step);
+
+		const int bayer[4][4] = { { 0, 8, 2, 10 }, { 12, 4, 14, 6 }, { 3, 11, 1, 9 }, { 15, 7, 13, 5 } };
+		for (int y = 0; y < 4; ++y)
+			for (int x = 0; x < 4; ++x)
+				table.dither[y][x] = (bayer[y][x] * SHADE_SUBSTEPS) / 16;
+
+		return table;
+	}
+
+	static constexpr ShadeTable SHADE_TABLE = MakeShadeTable();
+
+	/**
+	 * ShadeLevel()
+	 * @param lum The brightness, from 0.0f for black to 1.0f for white. Anything outside is clamped.
+	 * @return The brightness as one of SHADE_LEVELS levels.
+	 */
+	inline int ShadeLevel(const float& lum)
+	{
+		int level = (int)(lum * (float)SHADE_LEVELS);
+		return (level < 0) ? 0 : ((level >= SHADE_LEVELS) ? SHADE_LEVELS - 1 : level);
+	}
+
+	/**
+	 * ShadeColour()
+	 * @param baseColour One of the 16 FG_ colours.
+	 * @param lum The brightness, from 0.0f for black to 1.0f for white. Anything outside is clamped.
+	 * @return The nearest step of the colour's brightness ramp at or below lum.
+	 */
+	inline const Shade& ShadeColour(const short& baseColour, const float& lum)
+	{
+		return SHADE_TABLE.colours[baseColour & 0x0F][ShadeLevel(lum) / SHADE_SUBSTEPS];
+	}
+
+	/**
+	 * DitheredShade()
+	 * Picks between the two steps either side of a level so that, over a 4x4 block of cells, they mix in proportion to how far between them it is.
+	 * @param baseColour One of the 16 FG_ colours.
+	 * @param level The brightness from ShadeLevel().
+	 * @param x The column of the cell being shaded.
+	 * @param y The row of the cell being shaded.
+	 * @return The step of the colour's brightness ramp to draw the cell with.
+	 */
+	inline const Shade& DitheredShade(const short& baseColour, const int& level, const int& x, const int& y)
+	{
+		int step = (level + SHADE_TABLE.dither[y & 3][x & 3]) / SHADE_SUBSTEPS;
+		return SHADE_TABLE.colours[baseColour & 0x0F][(step < SHADE_STEPS) ? step : SHADE_STEPS - 1];
+	}
+} }
\ No newline at end of file
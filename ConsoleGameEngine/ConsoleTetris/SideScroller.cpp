@@ -22,6 +22,8 @@ SideScroller::SideScroller(GameEngine* engine, int appID, int width, int height,
  */
 SideScroller::~SideScroller()
 {
+	engine->DestroyGameObject(playerObject);
+
 	if (background1 != nullptr)
 		delete background1;
 	if (ground1 != nullptr)
@@ -37,8 +39,8 @@ SideScroller::~SideScroller()
  */
 int SideScroller::Update()
 {
-	if (!playerObject->isActive)
-		playerObject->isActive = true;
+	if (!engine->GameObjects().IsActive(playerObject))
+		engine->GameObjects().SetActive(playerObject, true);
 
 	GameLogic();
 	Draw();
@@ -47,7 +49,7 @@ int SideScroller::Update()
 		Reset();
 	if (InputHandler::Instance().IsKeyPressed(VK_ESCAPE))
 	{
-		playerObject->isActive = false;
+		engine->GameObjects().SetActive(playerObject, false);
 		Reset();
 		return 0;
 	}
@@ -66,12 +68,12 @@ void SideScroller::GameLogic()
 	// Movement
 	if (InputHandler::Instance().IsKeyHeld('D')) // Move Left
 	{
-		playerObject->GetSprite()->SetScale(1.0f, 1.0f);
+		player1->SetScale(1.0f, 1.0f);
 		playerVelocity.x = playerSpeed;
 	}
 	else if (InputHandler::Instance().IsKeyHeld('A')) // Move Right
 	{
-		playerObject->GetSprite()->SetScale(-1.0f, 1.0f);
+		player1->SetScale(-1.0f, 1.0f);
 		playerVelocity.x = -playerSpeed;
 	}
 	else
@@ -94,18 +96,19 @@ void SideScroller::GameLogic()
 		playerVelocity.y += GRAVITY;
 	
 	// Forces on player
-	playerObject->screenPosition += playerVelocity * Time::Instance().DeltaTime();
+	FVector2& playerPosition = engine->GameObjects().ScreenPosition(playerObject);
+	playerPosition += playerVelocity * Time::Instance().DeltaTime();
 
-	if (playerObject->screenPosition.x < 0)
-		playerObject->screenPosition.x = 0;
-	else if (playerObject->screenPosition.x + playerObject->GetSprite()->Width() >= screenWidth)
-		playerObject->screenPosition.x = screenWidth - playerObject->GetSprite()->Width();
+	if (playerPosition.x < 0)
+		playerPosition.x = 0;
+	else if (playerPosition.x + player1->Width() >= screenWidth)
+		playerPosition.x = screenWidth - player1->Width();
 
-	if (isJumping && playerObject->screenPosition.y > screenHeight - ground1->Height() - player1->Height())
+	if (isJumping && playerPosition.y > screenHeight - ground1->Height() - player1->Height())
 	{
 		isJumping = false;
 		playerVelocity.y = 0.0f;
-		playerObject->screenPosition.y = screenHeight - ground1->Height() - player1->Height();
+		playerPosition.y = screenHeight - ground1->Height() - player1->Height();
 	}
 }
 
@@ -140,5 +143,5 @@ void SideScroller::GenerateAssets()
 	player1 = new Sprite(L"../Assets/SideScroller/Player1.spr");
 
 	playerObject = engine->CreateGameObject(5, screenHeight - (ground1->Height() * 2), player1);
-	playerObject->isActive = false;
+	engine->GameObjects().SetActive(playerObject, false);
 }
\ No newline at end of file
@@ -13,7 +13,7 @@ private:
 	Sprite* player1;
 
 	// GameObjects
-	GameObject* playerObject;
+	GameObjectHandle playerObject;
 
 	// Properties
 	float backgroundXPos;
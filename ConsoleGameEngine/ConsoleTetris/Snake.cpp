@@ -1,3 +1,5 @@
+#include <cwchar>
+
 #include "Snake.h"
 
 /*
@@ -108,7 +110,8 @@ void Snake::Draw()
 	}
 
 	// Draw Score
-	std::wstring scoreText = L"SCORE: " + std::to_wstring(score);
+	wchar_t scoreText[32];
+	swprintf(scoreText, 32, L"SCORE: %d", score);
 	engine->DrawString(fieldWidth + 6, 2, scoreText, FG_WHITE);
 
 	// Gameover screen
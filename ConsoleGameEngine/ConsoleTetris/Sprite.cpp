@@ -1,7 +1,32 @@
+#include <cstdio>
+#include <cstring>
+#include <string>
+
 #include "Sprite.h"
 
 using namespace Engine::Graphics;
 
+/*
+ * OpenFile()
+ * Opens a file from a wide filename on any platform.
+ * @param filename The filename of the file.
+ * @param mode The mode to open the file in.
+ * @return The opened file, or nullptr if it could not be opened.
+ */
+static FILE* OpenFile(const std::wstring& filename, const wchar_t* mode)
+{
+	FILE* file = nullptr;
+#ifdef _WIN32
+	_wfopen_s(&file, filename.c_str(), mode);
+#else
+	// Asset paths are plain ASCII
+	std::string narrowFilename(filename.begin(), filename.end());
+	std::string narrowMode(mode, mode + wcslen(mode));
+	file = fopen(narrowFilename.c_str(), narrowMode.c_str());
+#endif
+	return file;
+}
+
 /*
  * Constructor - Default.
  */
@@ -24,7 +49,7 @@ Sprite::Sprite(int width, int height, float scaleX, float scaleY) : width(width)
  * Constructor - Load from file.
  * @param filename The filename of the sprite to be loaded.
  */
-Sprite::Sprite(std::wstring filename)
+Sprite::Sprite(std::wstring filename) : pixels(nullptr), colours(nullptr)
 {
 	if (!Load(filename))
 		Sprite();
@@ -45,6 +70,12 @@ int Sprite::Width() const { return width * abs(scale.x); }
 int Sprite::Height() const { return height * abs(scale.y); }
 const FVector2& Sprite::Scale() const { return scale; }
 
+// Unscaled texels, row by row, for code that reads many of them at once such as texturing
+int Sprite::TexelWidth() const { return width; }
+int Sprite::TexelHeight() const { return height; }
+const short* Sprite::Pixels() const { return pixels; }
+const short* Sprite::Colours() const { return colours; }
+
 short Sprite::GetPixel(const int& x, const int& y) const
 {
 	if (scale.x == 0 || scale.y == 0)
@@ -125,8 +156,7 @@ void Sprite::SetColour(const int& x, const int& y, const short& colour)
 
 bool Sprite::Save(std::wstring filename)
 {
-	FILE* file = nullptr;
-	_wfopen_s(&file, filename.c_str(), L"wb");
+	FILE* file = OpenFile(filename, L"wb");
 	if (file == nullptr)
 		return false;
 
@@ -150,8 +180,7 @@ bool Sprite::Load(std::wstring filename)
 	height = 0;
 	scale = FVector2(1.0f, 1.0f);
 
-	FILE* file = nullptr;
-	_wfopen_s(&file, filename.c_str(), L"rb");
+	FILE* file = OpenFile(filename, L"rb");
 	if (file == nullptr)
 		return false;
 
@@ -28,6 +28,10 @@ namespace Engine { namespace Graphics {
 		int Width() const;
 		int Height() const;
 		const FVector2& Scale() const;
+		int TexelWidth() const;
+		int TexelHeight() const;
+		const short* Pixels() const;
+		const short* Colours() const;
 		short GetPixel(const int& x, const int& y) const;
 		short GetColour(const int& x, const int& y) const;
 		short SamplePixel(const float& x, const float& y) const;
@@ -52,7 +52,7 @@ bool SpriteEditor::RunGame()
 	for (int i = 0; i < 7; ++i)
 	{
 		short colour = i + 9;
-		CHAR_INFO colourInfo;
+		CharInfo colourInfo;
 		if (colour == 15)
 			colourInfo = GetGreyScaleColour(currentBrightness / 19.0f);
 		else
@@ -119,7 +119,7 @@ void SpriteEditor::Input()
 	// Adds Pixel
 	if (InputHandler::Instance().IsKeyPressed(VK_RETURN))
 	{
-		CHAR_INFO info = GetColour(currentColour, currentBrightness / 19.0f);
+		CharInfo info = GetColour(currentColour, currentBrightness / 19.0f);
 		sprite->SetPixel(cursorPosition.x, cursorPosition.y, info.Char.UnicodeChar);
 		sprite->SetColour(cursorPosition.x, cursorPosition.y, info.Attributes);
 	}
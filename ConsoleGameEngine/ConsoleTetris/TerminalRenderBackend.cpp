@@ -0,0 +1,225 @@
+#include "TerminalRenderBackend.h"
+#ifndef _WIN32
+#include <errno.h>
+#include <poll.h>
+#include <stdio.h>
+#include <unistd.h>
+
+using namespace Engine::Graphics;
+
+// Maps the red/green/blue bits of a console colour to the ANSI colour order.
+static const int ansiColour[8] = { 0, 4, 2, 6, 1, 5, 3, 7 };
+
+// Worst case bytes per cell: a full SGR sequence ("\x1b[97;107m") plus a 3 byte UTF-8 character.
+static const int maxCellBytes = 13;
+// Worst case bytes per span: the cursor move sequence ("\x1b[RRRRR;CCCCCH").
+static const int maxSpanBytes = 16;
+// Room for the title and the frame prefix and suffix.
+static const int maxHeaderBytes = 1024;
+
+/**
+ * Constructor
+ */
+TerminalRenderBackend::TerminalRenderBackend() : output(nullptr), outputSize(0), outputLength(0), screenWidth(0), screenHeight(0), currentAttributes(-1) { }
+
+/**
+ * Destructor
+ * Puts the terminal back how it was found.
+ */
+TerminalRenderBackend::~TerminalRenderBackend()
+{
+	if (output != nullptr)
+	{
+		outputLength = 0;
+		Write("\x1b[0m\x1b[?25h\x1b[?1049l");
+		Flush();
+		delete[] output;
+	}
+}
+
+/**
+ * SetupWindow()
+ * Switches the terminal to the alternate screen and sizes the output buffer for the new screen.
+ * Terminals do not allow the font to be changed so the font size is ignored.
+ * @param width The width of the screen in characters.
+ * @param height The height of the screen in characters.
+ * @param fontWidth Unused.
+ * @param fontHeight Unused.
+ */
+void TerminalRenderBackend::SetupWindow(const int& width, const int& height, const int& /*fontWidth*/, const int& /*fontHeight*/)
+{
+	screenWidth = width;
+	screenHeight = height;
+
+	if (output != nullptr)
+		delete[] output;
+
+	outputSize = (screenWidth * screenHeight * maxCellBytes) + (screenHeight * maxSpanBytes) + maxHeaderBytes;
+	output = new char[outputSize];
+	outputLength = 0;
+
+	// Alternate screen, hidden cursor, reset colours, clear and ask the terminal to resize to fit
+	Write("\x1b[?1049h\x1b[?25l\x1b[0m\x1b[2J\x1b[8;");
+	WriteNumber(screenHeight);
+	Write(";");
+	WriteNumber(screenWidth);
+	Write("t");
+	Flush();
+
+	currentAttributes = -1;
+}
+
+/**
+ * Draw()
+ * Takes an array of characters and draws the changed spans of it to the terminal.
+ * Colour codes are only sent when the attributes change from the previous character.
+ * @param title The name of the program to be displayed on the top bar.
+ * @param characterArray The array of characters that will be drawn to the terminal.
+ * @param spans The changed spans of each dirty row, in row order.
+ * @param spanCount The number of spans given.
+ * @param stats The timings of the frame to show on the top bar.
+ */
+void TerminalRenderBackend::Draw(const wchar_t* title, const CharInfo* characterArray, const DirtySpan* spans, const int& spanCount, const FrameStats& stats)
+{
+	outputLength = 0;
+
+	// Title
+	char s[128];
+	Write("\x1b]0;");
+	for (int i = 0; title[i] != 0 && i < 256; ++i)
+		WriteCharacter((unsigned int)title[i]);
+	snprintf(s, 128, " - FPS: %3.2f - Run: %3.2f - Rend: %3.2f - Cells: %d - Allocs: %d\x07", stats.fps, stats.runTime, stats.renderTime, stats.changedCells, stats.allocations);
+	Write(s);
+
+	for (int i = 0; i < spanCount; ++i)
+	{
+		// Move cursor to the start of the span (1 based)
+		Write("\x1b[");
+		WriteNumber(spans[i].row + 1);
+		Write(";");
+		WriteNumber(spans[i].minX + 1);
+		Write("H");
+
+		const CharInfo* cell = &characterArray[(spans[i].row * screenWidth) + spans[i].minX];
+		for (int x = spans[i].minX; x <= spans[i].maxX; ++x, ++cell)
+		{
+			if (cell->Attributes != currentAttributes)
+				WriteAttributes(cell->Attributes);
+			WriteCharacter(cell->Char.UnicodeChar);
+		}
+	}
+
+	Flush();
+}
+
+// OUTPUT FUNCTIONS ##########################################################################################################################################
+
+/**
+ * Write()
+ * Appends a null terminated string to the output buffer.
+ * @param text The text to add.
+ */
+void TerminalRenderBackend::Write(const char* text)
+{
+	while (*text != 0 && outputLength < outputSize)
+		output[outputLength++] = *text++;
+}
+
+/**
+ * WriteNumber()
+ * Appends a positive number to the output buffer as decimal text.
+ * @param number The number to add.
+ */
+void TerminalRenderBackend::WriteNumber(int number)
+{
+	char digits[12];
+	int count = 0;
+	do
+	{
+		digits[count++] = '0' + (number % 10);
+		number /= 10;
+	} while (number > 0 && count < 12);
+
+	while (count > 0 && outputLength < outputSize)
+		output[outputLength++] = digits[--count];
+}
+
+/**
+ * WriteCharacter()
+ * Appends a character to the output buffer encoded as UTF-8.
+ * Control characters (including empty cells) are written as spaces.
+ * @param character The unicode value of the character.
+ */
+void TerminalRenderBackend::WriteCharacter(const unsigned int& character)
+{
+	if (outputLength + 3 > outputSize)
+		return;
+
+	if (character < 0x20 || character == 0x7F)
+		output[outputLength++] = ' ';
+	else if (character < 0x80)
+		output[outputLength++] = (char)character;
+	else if (character < 0x800)
+	{
+		output[outputLength++] = (char)(0xC0 | (character >> 6));
+		output[outputLength++] = (char)(0x80 | (character & 0x3F));
+	}
+	else
+	{
+		output[outputLength++] = (char)(0xE0 | ((character >> 12) & 0x0F));
+		output[outputLength++] = (char)(0x80 | ((character >> 6) & 0x3F));
+		output[outputLength++] = (char)(0x80 | (character & 0x3F));
+	}
+}
+
+/**
+ * WriteAttributes()
+ * Appends the SGR sequence that matches a console colour attribute (FG_* | BG_*).
+ * Bright colours use the 90-97 and 100-107 codes.
+ * @param attributes The console colour attribute.
+ */
+void TerminalRenderBackend::WriteAttributes(const unsigned short& attributes)
+{
+	int foreground = attributes & 0x0F;
+	int background = (attributes >> 4) & 0x0F;
+
+	Write("\x1b[");
+	WriteNumber(ansiColour[foreground & 0x07] + ((foreground & 0x08) ? 90 : 30));
+	Write(";");
+	WriteNumber(ansiColour[background & 0x07] + ((background & 0x08) ? 100 : 40));
+	Write("m");
+
+	currentAttributes = attributes;
+}
+
+/**
+ * Flush()
+ * Sends the output buffer to stdout.
+ * This is one write() call unless the terminal only accepts part of the frame. The rest is retried until it is all sent,
+ * waiting for room if stdout is non-blocking, as the cells have already been recorded as drawn.
+ */
+void TerminalRenderBackend::Flush()
+{
+	int written = 0;
+	while (written < outputLength)
+	{
+		ssize_t result = write(STDOUT_FILENO, output + written, outputLength - written);
+		if (result > 0)
+		{
+			written += (int)result;
+			continue;
+		}
+
+		if (result < 0 && errno == EINTR)
+			continue;
+		if (result < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+		{
+			struct pollfd ready = { STDOUT_FILENO, POLLOUT, 0 };
+			if (poll(&ready, 1, -1) >= 0 || errno == EINTR)
+				continue;
+		}
+		break;
+	}
+	outputLength = 0;
+}
+#endif
@@ -0,0 +1,37 @@
+#pragma once
+#ifndef _WIN32
+#include "RenderBackend.h"
+
+namespace Engine { namespace Graphics {
+	/**
+	 * TerminalRenderBackend
+	 * Draws the screen buffer to a VT compatible terminal on stdout using escape sequences.
+	 * Each frame is built in one preallocated byte buffer and sent with a single write().
+	 */
+	class TerminalRenderBackend : public RenderBackend
+	{
+	private:
+		char* output;
+		int outputSize;
+		int outputLength;
+
+		int screenWidth;
+		int screenHeight;
+		int currentAttributes;
+
+		// Output Functions
+		void Write(const char* text);
+		void WriteNumber(int number);
+		void WriteCharacter(const unsigned int& character);
+		void WriteAttributes(const unsigned short& attributes);
+		void Flush(void);
+
+	public:
+		TerminalRenderBackend(void);
+		~TerminalRenderBackend(void);
+
+		void SetupWindow(const int& width, const int& height, const int& fontWidth, const int& fontHeight) override;
+		void Draw(const wchar_t* title, const CharInfo* characterArray, const DirtySpan* spans, const int& spanCount, const FrameStats& stats) override;
+	};
+} }
+#endif
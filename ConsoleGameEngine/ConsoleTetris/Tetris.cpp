@@ -1,3 +1,5 @@
+#include <cwchar>
+
 #include "Tetris.h"
 
 /**
@@ -199,7 +201,8 @@ void Tetris::Draw()
 				engine->DrawChar(currentX + x + 2, currentY + y + 2, PIXEL_SOLID, tetroColours[currentPiece]);
 
 	// Draw Score
-	std::wstring scoreText = L"SCORE: " + std::to_wstring(score);
+	wchar_t scoreText[32];
+	swprintf(scoreText, 32, L"SCORE: %d", score);
 	engine->DrawString(fieldWidth + 6, 2, scoreText, FG_WHITE);
 
 	// Gameover screen
@@ -0,0 +1,150 @@
+#include "ThreadPool.h"
+
+/**
+ * Constructor
+ * @param workerCount The number of threads to start, besides the one that calls Run().
+ */
+Engine::ThreadPool::ThreadPool(const int& workerCount) : job(nullptr), context(nullptr), jobCount(0), batch(0), busyWorkers(0), stopping(false)
+{
+	nextJob = 0;
+	StartWorkers(workerCount);
+}
+
+/**
+ * Destructor
+ */
+Engine::ThreadPool::~ThreadPool()
+{
+	StopWorkers();
+}
+
+/**
+ * DefaultWorkerCount()
+ * @return One worker for every hardware thread other than the one that will be calling Run().
+ */
+int Engine::ThreadPool::DefaultWorkerCount()
+{
+	int hardwareThreads = (int)std::thread::hardware_concurrency();
+	return (hardwareThreads > 1) ? hardwareThreads - 1 : 0;
+}
+
+/**
+ * WorkerCount()
+ * @return The number of worker threads, not counting the thread that calls Run().
+ */
+int Engine::ThreadPool::WorkerCount() const { return (int)workers.size(); }
+
+/**
+ * Resize()
+ * Replaces the workers with a new set. Must not be called while a batch is running.
+ * @param workerCount The number of threads to start, besides the one that calls Run().
+ */
+void Engine::ThreadPool::Resize(const int& workerCount)
+{
+	StopWorkers();
+	StartWorkers(workerCount);
+}
+
+/**
+ * Run()
+ * Runs job(context, index) for every index from 0 to count - 1 on the workers and the calling thread,
+ * returning when they have all finished. With no workers, or only one job, everything runs on the calling thread.
+ * @param count The number of jobs.
+ * @param job The function to run for each job.
+ * @param context Passed to every call of the job.
+ */
+void Engine::ThreadPool::Run(const int& count, Job job, void* context)
+{
+	if (count <= 0)
+		return;
+
+	if (workers.empty() || count == 1)
+	{
+		for (int i = 0; i < count; ++i)
+			job(context, i);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		this->job = job;
+		this->context = context;
+		jobCount = count;
+		nextJob = 0;
+		busyWorkers = (int)workers.size();
+		++batch;
+	}
+	wake.notify_all();
+
+	RunJobs();
+
+	// Every worker has to be done with this batch before its job and context can be replaced
+	std::unique_lock<std::mutex> lock(mutex);
+	finished.wait(lock, [this] { return busyWorkers == 0; });
+}
+
+/**
+ * WorkerLoop()
+ * Runs on each worker, sleeping until a new batch is handed over and then helping with it.
+ * @param lastBatch The batch number when the worker was started, so a batch handed over before it first gets to wait isn't missed.
+ */
+void Engine::ThreadPool::WorkerLoop(unsigned int lastBatch)
+{
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			wake.wait(lock, [&] { return stopping || batch != lastBatch; });
+
+			if (stopping)
+				return;
+
+			lastBatch = batch;
+		}
+
+		RunJobs();
+
+		std::lock_guard<std::mutex> lock(mutex);
+		if (--busyWorkers == 0)
+			finished.notify_one();
+	}
+}
+
+/**
+ * RunJobs()
+ * Takes jobs from the current batch until there are none left.
+ */
+void Engine::ThreadPool::RunJobs()
+{
+	for (int i = nextJob++; i < jobCount; i = nextJob++)
+		job(context, i);
+}
+
+/**
+ * StartWorkers()
+ * @param workerCount The number of threads to start.
+ */
+void Engine::ThreadPool::StartWorkers(const int& workerCount)
+{
+	stopping = false;
+	for (int i = 0; i < workerCount; ++i)
+		workers.push_back(std::thread(&ThreadPool::WorkerLoop, this, batch));
+}
+
+/**
+ * StopWorkers()
+ * Wakes every worker so it can see it should stop, then waits for them all to exit.
+ */
+void Engine::ThreadPool::StopWorkers()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	wake.notify_all();
+
+	for (std::thread& worker : workers)
+		worker.join();
+
+	workers.clear();
+}
\ No newline at end of file
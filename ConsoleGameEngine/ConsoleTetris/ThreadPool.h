@@ -0,0 +1,66 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Engine
+{
+	/**
+	 * ThreadPool
+	 * A fixed set of worker threads that share out a batch of independent jobs with the thread that hands them over.
+	 * Jobs are taken one at a time from a shared counter, so uneven jobs still balance out, and Run() only returns once
+	 * every job in the batch is done. Running a batch makes no heap allocations.
+	 */
+	class ThreadPool
+	{
+	public:
+		typedef void (*Job)(void* context, int index);
+
+	private:
+		std::vector<std::thread> workers;
+		std::mutex mutex;
+		std::condition_variable wake;
+		std::condition_variable finished;
+
+		// The current batch
+		Job job;
+		void* context;
+		int jobCount;
+		std::atomic<int> nextJob;
+		unsigned int batch;
+		int busyWorkers;
+		bool stopping;
+
+		void WorkerLoop(unsigned int lastBatch);
+		void RunJobs(void);
+		void StartWorkers(const int& workerCount);
+		void StopWorkers(void);
+
+	public:
+		ThreadPool(const int& workerCount = DefaultWorkerCount());
+		~ThreadPool(void);
+
+		static int DefaultWorkerCount(void);
+
+		int WorkerCount(void) const;
+		void Resize(const int& workerCount);
+		void Run(const int& count, Job job, void* context);
+
+		/**
+		 * ParallelFor()
+		 * Calls function(index) for every index from 0 to count - 1, spread across the pool.
+		 * @param count The number of jobs.
+		 * @param function Anything callable with an int, which must be safe to call from several threads at once.
+		 */
+		template <typename Function>
+		void ParallelFor(const int& count, Function& function)
+		{
+			Run(count, [](void* context, int index) { (*static_cast<Function*>(context))(index); }, &function);
+		}
+
+		ThreadPool(ThreadPool const&) = delete;
+		void operator=(ThreadPool const&) = delete;
+	};
+}
\ No newline at end of file
@@ -1,5 +1,16 @@
 #include "ThreeDimentions.h"
 
+// How far triangles can reach past the screen before being clipped, in half screens from its centre - the rasteriser keeps to the screen itself
+static const float GUARD_BAND = 4.0f;
+
+// The field of heads behind the main one, all instances of the same mesh
+static const int FIELD_SIZE = 16;
+static const float FIELD_SPACING = 3.0f;
+static const short FIELD_COLOURS[] = { FG_RED, FG_GREEN, FG_BLUE, FG_CYAN, FG_MAGENTA, FG_YELLOW };
+
+// Where the textured cubes either side of the head sit
+static const FVector3 CUBE_POSITIONS[] = { FVector3(-3.5f, 0.0f, 6.0f), FVector3(3.5f, 0.0f, 6.0f) };
+
 /*
  * Constructor
  * @param screenBuffer A pointer to the screenbuffer to be able to draw to.
@@ -14,7 +25,7 @@
  */
 ThreeDimentions::ThreeDimentions(GameEngine* engine, int appID, int width, int height, int fontWidth, int fontHeight) : Application(engine, appID, width, height, fontWidth, fontHeight),
 	fov(90.0f), farClippingPlane(1000.0f), nearClippingPlane(0.1f), aspectRatio(height / width), xRotSpeed(1.0f), yRotSpeed(0.0f), zRotSpeed(0.75f), xRotAngle(0.0f), yRotAngle(0.0f), zRotAngle(0.0f),
-	cameraPos(), cameraUp(0.0f, 1.0f, 0.0f), lookDirection(0.0f, 0.0f, 1.0f), cameraTarget(cameraPos + lookDirection), yaw(0.0f)
+	cameraPos(), cameraUp(0.0f, 1.0f, 0.0f), lookDirection(0.0f, 0.0f, 1.0f), cameraTarget(cameraPos + lookDirection), yaw(0.0f), gouraudShading(true)
 { 
 	GenerateAssets();
 }
@@ -22,11 +33,7 @@ ThreeDimentions::ThreeDimentions(GameEngine* engine, int appID, int width, int h
 /**
  * Destructor
  */
-ThreeDimentions::~ThreeDimentions()
-{
-	delete cubeMesh;
-	delete axisMesh;
-}
+ThreeDimentions::~ThreeDimentions() { }
 
 /*
  * Update()
@@ -38,6 +45,12 @@ int ThreeDimentions::Update()
 	GameLogic();
 	Draw();
 
+	// Shading
+	if (InputHandler::Instance().IsKeyPressed('G'))
+		gouraudShading = !gouraudShading;
+	if (InputHandler::Instance().IsKeyPressed('T'))
+		engine->SetShadeDithering(!engine->ShadeDithering());
+
 	if (InputHandler::Instance().IsKeyPressed(VK_RETURN))
 		Reset();
 	if (InputHandler::Instance().IsKeyPressed(VK_ESCAPE))
@@ -106,120 +119,202 @@ void ThreeDimentions::GameLogic()
 void ThreeDimentions::Draw()
 {
 	engine->ClearScreen();
+	engine->ClearDepth();
 
 	Matrix4x4 viewMat = Matrix4x4::InvertPointAtMatrix(cameraMat);
+	Matrix4x4 viewProjectionMat = viewMat * projectionMat;
+	Frustum frustum = Frustum::FromMatrix(viewProjectionMat);
 
 	// Object Matrises
 	Matrix4x4 transformMat = Matrix4x4::TranslationMatrix(0.0f, 0.0f, 6.0f);
 	Matrix4x4 worldMat = rotZMat * rotXMat;
 	worldMat *= rotYMat;
 	worldMat *= transformMat;
+	scene.Instance(headMesh, headInstance).world = worldMat;
 
-	// Stores triangle for rastering.
-	std::vector<Triangle> triangleBuffer;
-
-	for (auto tri : cubeMesh->tris)
+	for (size_t i = 0; i < sizeof(CUBE_POSITIONS) / sizeof(CUBE_POSITIONS[0]); ++i)
 	{
-		Triangle triTransformed = tri * worldMat;
+		Matrix4x4 cubeMat = (i == 0) ? rotYMat * rotXMat : rotXMat * rotZMat;
+		scene.Instance(cubeMesh, i).world = cubeMat * Matrix4x4::TranslationMatrix(CUBE_POSITIONS[i].x, CUBE_POSITIONS[i].y, CUBE_POSITIONS[i].z);
+	}
 
-		// CROSS PRODUCT
-		FVector3 normal = (triTransformed.points[1] - triTransformed.points[0]).CrossProduct(triTransformed.points[2] - triTransformed.points[0]);
-		normal = normal.Normalized();
+	// Stores triangle for rastering - taken from the frame arena so no heap allocations are made per frame
+	ArenaAllocator<Triangle> arena(engine->Arena());
+	TriangleList rasterList(arena);
 
-		// DOT PRODUCT - Culls tris on the back of the mesh (from camera perspective
-		if (normal.DotProduct(triTransformed.points[0] - cameraPos) < 0.0f)
-		{
-			// Illumination
-			FVector3 directionalLight = FVector3(0.0f, 1.0f, -1.0f);
-			directionalLight = directionalLight.Normalized();
+	for (size_t i = 0; i < scene.BatchCount(); ++i)
+		DrawBatch(scene.Batch(i), viewProjectionMat, frustum, rasterList);
 
-			CHAR_INFO c = GetColour(FG_RED, normal.DotProduct(directionalLight));
-			triTransformed.pixel = c.Char.UnicodeChar;
-			triTransformed.colour = c.Attributes;
+	// Draw Tris - every instance of every mesh in one depth tested pass
+	engine->DrawFillTrianglesDepth(rasterList.data(), rasterList.size());
 
-			// Convert World Space -> View Space
-			Triangle triViewed = triTransformed * viewMat;
+	for (int i = 0; i < 19; ++i)
+	{
+		CharInfo colour = engine->GetColour(FG_MAGENTA, (float)(i) / 19.0f);
+		engine->DrawRectFill(i * 9, 0, (i * 9) + 8, 24, colour.Char.UnicodeChar, colour.Attributes, colour.Char.UnicodeChar, colour.Attributes);
+	}
+}
 
-			// Clipped viewed triangle against near plane
-			int clippedTris = 0;
-			Triangle clipped[2];					// Position of the plane in screen scace  // Normal in screen space  <- NOT WORLD SPACE 
-			clippedTris = triViewed.ClipAgainstPlane(FVector3(0.0f, 0.0f, nearClippingPlane), FVector3(0.0f, 0.0f, 1.0f), clipped[0], clipped[1]);
+/*
+ * DrawBatch()
+ * Culls the instances of a mesh against the frustum, transforms all of those left in one pass and adds their triangles to the list to raster.
+ * @param batch The mesh and its instances.
+ * @param viewProjectionMat The view matrix of the camera multiplied by the projection matrix.
+ * @param frustum The frustum of the camera.
+ * @param rasterList The list to add the screen space triangles to.
+ */
+void ThreeDimentions::DrawBatch(const MeshBatch& batch, const Matrix4x4& viewProjectionMat, const Frustum& frustum, TriangleList& rasterList)
+{
+	const Mesh& mesh = *batch.mesh;
+	const Sprite* texture = mesh.Textured() ? batch.texture : nullptr;
+
+	std::vector<Matrix4x4, ArenaAllocator<Matrix4x4>> worlds((ArenaAllocator<Matrix4x4>(engine->Arena())));
+	std::vector<Frustum::Containment, ArenaAllocator<Frustum::Containment>> containments((ArenaAllocator<Frustum::Containment>(engine->Arena())));
+	std::vector<short, ArenaAllocator<short>> colours((ArenaAllocator<short>(engine->Arena())));
+	worlds.reserve(batch.instances.size());
+	containments.reserve(batch.instances.size());
+	colours.reserve(batch.instances.size());
+
+	// Frustum Culling - an instance whose bounding sphere can't be seen isn't transformed at all
+	for (const SceneInstance& instance : batch.instances)
+	{
+		if (!instance.visible)
+			continue;
 
-			// Apply projection
-			for (int i = 0; i < clippedTris; ++i)
-			{
-				Triangle triProjected = clipped[i] * projectionMat;
-				triProjected.points[0].x *= -1.0f;
-				triProjected.points[1].x *= -1.0f;
-				triProjected.points[2].x *= -1.0f;
-				triProjected.points[0].y *= -1.0f;
-				triProjected.points[1].y *= -1.0f;
-				triProjected.points[2].y *= -1.0f;
-
-				triProjected += FVector3(1.0f, 1.0f, 0.0f);
-				triProjected *= FVector3(0.5f * (float)screenWidth, 0.5f * (float)screenHeight, 1.0f);
-
-				// Store triangle for sorting
-				triangleBuffer.push_back(triProjected);
-			}
-		}
+		Frustum::Containment containment = frustum.ClassifySphere(mesh.boundsCentre * instance.world, mesh.boundsRadius * instance.world.MaxScale());
+		if (containment == Frustum::Containment::Outside)
+			continue;
+
+		worlds.push_back(instance.world);
+		containments.push_back(containment);
+		colours.push_back(instance.colour);
 	}
 
-	// Sort Triangle back to front
-	sort(triangleBuffer.begin(), triangleBuffer.end(), [](Triangle &t1, Triangle &t2)
+	if (worlds.empty())
+		return;
+
+	// Take every shared vertex into world and clip space once per instance, reading the mesh once for all of them
+	TransformedMesh* vertices = static_cast<TransformedMesh*>(engine->Arena().Allocate(sizeof(TransformedMesh) * worlds.size(), alignof(TransformedMesh)));
+	mesh.TransformInstances(worlds.data(), worlds.size(), viewProjectionMat, engine->Arena(), vertices);
+	rasterList.reserve(rasterList.size() + (mesh.TriangleCount() * worlds.size()));
+
+	for (size_t i = 0; i < worlds.size(); ++i)
+		DrawInstance(mesh, texture, worlds[i], vertices[i], containments[i], colours[i], rasterList);
+}
+
+/*
+ * DrawInstance()
+ * Lights and projects the triangles of one instance of a mesh facing the camera, clipping any that need it, and adds them to the list to raster.
+ * With Gouraud shading each vertex is lit by its own normal and the rasteriser blends the brightness across each triangle, otherwise
+ * every triangle is lit by its face normal. Textured meshes aren't lit, their texture is drawn as it is.
+ * @param mesh The mesh to draw.
+ * @param texture The texture to draw the mesh with, or nullptr to light it.
+ * @param worldMat The world matrix of the instance.
+ * @param vertices The vertices of the mesh transformed for the instance.
+ * @param containment Where the instance's bounding sphere is relative to the frustum.
+ * @param colour The colour to light the instance with.
+ * @param rasterList The list to add the screen space triangles to.
+ */
+void ThreeDimentions::DrawInstance(const Mesh& mesh, const Sprite* texture, const Matrix4x4& worldMat, const TransformedMesh& vertices, const Frustum::Containment& containment, const short& colour, TriangleList& rasterList)
+{
+	FVector3 directionalLight = FVector3(0.0f, 1.0f, -1.0f).Normalized();
+
+	// Vertex Lighting - the light is taken into model space instead of every normal into world space, which holds for rotations and uniform scaling
+	float* vertexShades = nullptr;
+	if (gouraudShading && texture == nullptr)
 	{
-		float z1 = (t1.points[0].z + t1.points[1].z + t1.points[2].z) / 3.0f;
-		float z2 = (t2.points[0].z + t2.points[1].z + t2.points[2].z) / 3.0f;
-		return z1 > z2;
-	});
+		const float (&m)[4][4] = worldMat.matrix;
+		float inverseScale = 1.0f / worldMat.MaxScale();
+		FVector3 modelLight = FVector3((m[0][0] * directionalLight.x) + (m[0][1] * directionalLight.y) + (m[0][2] * directionalLight.z),
+									   (m[1][0] * directionalLight.x) + (m[1][1] * directionalLight.y) + (m[1][2] * directionalLight.z),
+									   (m[2][0] * directionalLight.x) + (m[2][1] * directionalLight.y) + (m[2][2] * directionalLight.z)) * inverseScale;
+
+		vertexShades = static_cast<float*>(engine->Arena().Allocate(sizeof(float) * mesh.VertexCount()));
+		for (size_t i = 0; i < mesh.VertexCount(); ++i)
+			vertexShades[i] = (mesh.normalX[i] * modelLight.x) + (mesh.normalY[i] * modelLight.y) + (mesh.normalZ[i] * modelLight.z);
+	}
 
-	for (auto& triToRaster : triangleBuffer)
+	const unsigned int* indices = mesh.indices.data();
+	for (size_t t = 0; t < mesh.TriangleCount(); ++t)
 	{
-		// Clipping to the screen edges
-		Triangle clipped[2];
-		std::list<Triangle> triangleList;
-		triangleList.push_back(triToRaster);
-		int newTriangles = 1;
+		unsigned int a = indices[t * 3], b = indices[(t * 3) + 1], c = indices[(t * 3) + 2];
+		FVector3 worldA = FVector3(vertices.worldX[a], vertices.worldY[a], vertices.worldZ[a]);
+		FVector3 worldB = FVector3(vertices.worldX[b], vertices.worldY[b], vertices.worldZ[b]);
+		FVector3 worldC = FVector3(vertices.worldX[c], vertices.worldY[c], vertices.worldZ[c]);
 
-		FVector3 topLeft = FVector3(0.0f, 0.0f, 0.0f);
-		FVector3 bottom = FVector3(0.0f, (float)screenHeight - 1.0f, 0.0f);
-		FVector3 right = FVector3((float)screenWidth - 1.0f, 0.0f, 0.0f);
+		// CROSS PRODUCT
+		FVector3 normal = (worldB - worldA).CrossProduct(worldC - worldA);
+		normal = normal.Normalized();
 
-		for (int p = 0; p < 4; ++p)
+		// DOT PRODUCT - Culls tris on the back of the mesh (from camera perspective
+		if (normal.DotProduct(worldA - cameraPos) >= 0.0f)
+			continue;
+
+		// Illumination
+		float faceShade = normal.DotProduct(directionalLight);
+		float shadeA = (vertexShades != nullptr) ? vertexShades[a] : faceShade;
+		float shadeB = (vertexShades != nullptr) ? vertexShades[b] : faceShade;
+		float shadeC = (vertexShades != nullptr) ? vertexShades[c] : faceShade;
+
+		ClipVertex polygon[CLIP_MAX_VERTICES] = { { vertices.clipX[a], vertices.clipY[a], vertices.clipZ[a], vertices.clipW[a], shadeA, 0.0f, 0.0f },
+												  { vertices.clipX[b], vertices.clipY[b], vertices.clipZ[b], vertices.clipW[b], shadeB, 0.0f, 0.0f },
+												  { vertices.clipX[c], vertices.clipY[c], vertices.clipZ[c], vertices.clipW[c], shadeC, 0.0f, 0.0f } };
+		if (texture != nullptr)
 		{
-			int trisToAdd = 0;
-			while (newTriangles > 0)
-			{
-				Triangle test = triangleList.front();
-				triangleList.pop_front();
-				--newTriangles;
-				switch (p)
-				{
-				case 0: trisToAdd = test.ClipAgainstPlane(FVector3(0.0f, 0.0f, 0.0f),                       FVector3( 0.0f,  1.0f, 0.0f), clipped[0], clipped[1]); break;
-				case 1: trisToAdd = test.ClipAgainstPlane(FVector3(0.0f, (float)screenHeight - 1.0f, 0.0f), FVector3( 0.0f, -1.0f, 0.0f), clipped[0], clipped[1]); break;
-				case 2: trisToAdd = test.ClipAgainstPlane(FVector3(0.0f, 0.0f, 0.0f),                       FVector3( 1.0f,  0.0f, 0.0f), clipped[0], clipped[1]); break;
-				case 3: trisToAdd = test.ClipAgainstPlane(FVector3((float)screenWidth - 1.0f, 0.0f, 0.0f),  FVector3(-1.0f,  0.0f, 0.0f), clipped[0], clipped[1]); break;
-				}
-
-				for (int w = 0; w < trisToAdd; ++w)
-					triangleList.push_back(clipped[w]);
-			}
-			newTriangles = triangleList.size();
+			polygon[0].u = mesh.texU[a]; polygon[0].v = mesh.texV[a];
+			polygon[1].u = mesh.texU[b]; polygon[1].v = mesh.texV[b];
+			polygon[2].u = mesh.texU[c]; polygon[2].v = mesh.texV[c];
 		}
+		int count = 3;
+
+		// Clipping - only triangles poking out of the near or far plane or the guard band, of instances not wholly in view, are clipped
+		if (containment == Frustum::Containment::Intersecting)
+		{
+			int outcodeA = ClipOutcode(polygon[0], GUARD_BAND);
+			int outcodeB = ClipOutcode(polygon[1], GUARD_BAND);
+			int outcodeC = ClipOutcode(polygon[2], GUARD_BAND);
 
+			// Every point outside the same plane
+			if ((outcodeA & outcodeB & outcodeC) != 0)
+				continue;
 
-		// Draw Tris
-		for (auto &tri : triangleList)
+			if ((outcodeA | outcodeB | outcodeC) != 0)
+				count = ClipPolygon(polygon, count, outcodeA | outcodeB | outcodeC, GUARD_BAND);
+		}
+
+		// Clip Space -> Screen Space
+		FVector3 points[CLIP_MAX_VERTICES];
+		float inverseW[CLIP_MAX_VERTICES];
+		for (int i = 0; i < count; ++i)
 		{
-			engine->DrawFillTriangle(tri.points[0].x, tri.points[0].y, tri.points[1].x, tri.points[1].y, tri.points[2].x, tri.points[2].y, tri.pixel, tri.colour);
-			//engine->DrawTriangle(tri.points[0].x, tri.points[0].y, tri.points[1].x, tri.points[1].y, tri.points[2].x, tri.points[2].y, PIXEL_SOLID, FG_BLACK);
+			inverseW[i] = 1.0f / polygon[i].w;
+			points[i] = FVector3((1.0f - (polygon[i].x * inverseW[i])) * 0.5f * (float)screenWidth,
+								 (1.0f - (polygon[i].y * inverseW[i])) * 0.5f * (float)screenHeight,
+								 polygon[i].z * inverseW[i]);
 		}
-	}
 
-	for (int i = 0; i < 19; ++i)
-	{
-		CHAR_INFO colour = GetColour(FG_MAGENTA, (float)(i) / 19.0f);
-		engine->DrawRectFill(i * 9, 0, (i * 9) + 8, 24, colour.Char.UnicodeChar, colour.Attributes, colour.Char.UnicodeChar, colour.Attributes);
+		// Store triangles for rastering, as a fan if clipping cut corners off
+		for (int i = 1; i + 1 < count; ++i)
+		{
+			Triangle triProjected(points[0], points[i], points[i + 1]);
+			triProjected.shadeColour = colour;
+			triProjected.shades[0] = polygon[0].shade;
+			triProjected.shades[1] = polygon[i].shade;
+			triProjected.shades[2] = polygon[i + 1].shade;
+
+			if (texture != nullptr)
+			{
+				const int corners[3] = { 0, i, i + 1 };
+				for (int k = 0; k < 3; ++k)
+				{
+					triProjected.texU[k] = polygon[corners[k]].u;
+					triProjected.texV[k] = polygon[corners[k]].v;
+					triProjected.inverseW[k] = inverseW[corners[k]];
+				}
+				triProjected.texture = texture;
+			}
+			rasterList.push_back(triProjected);
+		}
 	}
 }
 
@@ -234,88 +329,30 @@ void ThreeDimentions::Reset()
 
 void ThreeDimentions::GenerateAssets() 
 {
-	cubeMesh = new Mesh();
-	cubeMesh->LoadFromObjFile("../Assets/Models/Head.obj");
-	axisMesh = new Mesh();
-	axisMesh->LoadFromObjFile("../Assets/Models/axis.obj");
-
-	// Projection Matrix
-	projectionMat = Matrix4x4::ProjectionMatrix(aspectRatio, fov, nearClippingPlane, farClippingPlane);
-}
-
-CHAR_INFO ThreeDimentions::GetColour(const float& lum)
-{
-	short bgCol, fgCol;
-	short sym;
-	int pixelBw = (int)(13.0f * lum);
-
-	switch (pixelBw)
-	{
-	case 0: bgCol = BG_BLACK; fgCol = FG_DARK_GREY; sym = PIXEL_QUARTER; break;
-
-	case 1: bgCol = BG_BLACK; fgCol = FG_DARK_GREY; sym = PIXEL_QUARTER; break;
-	case 2: bgCol = BG_BLACK; fgCol = FG_DARK_GREY; sym = PIXEL_HALF; break;
-	case 3: bgCol = BG_BLACK; fgCol = FG_DARK_GREY; sym = PIXEL_THREEQUARTER; break;
-	case 4: bgCol = BG_BLACK; fgCol = FG_DARK_GREY; sym = PIXEL_SOLID; break;
-
-	case 5: bgCol = BG_DARK_GREY; fgCol = FG_GREY; sym = PIXEL_QUARTER; break;
-	case 6: bgCol = BG_DARK_GREY; fgCol = FG_GREY; sym = PIXEL_HALF; break;
-	case 7: bgCol = BG_DARK_GREY; fgCol = FG_GREY; sym = PIXEL_THREEQUARTER; break;
-	case 8: bgCol = BG_DARK_GREY; fgCol = FG_GREY; sym = PIXEL_SOLID; break;
-
-	case 9:  bgCol = BG_GREY; fgCol = FG_WHITE; sym = PIXEL_QUARTER; break;
-	case 10: bgCol = BG_GREY; fgCol = FG_WHITE; sym = PIXEL_HALF; break;
-	case 11: bgCol = BG_GREY; fgCol = FG_WHITE; sym = PIXEL_THREEQUARTER; break;
-	case 12: bgCol = BG_GREY; fgCol = FG_WHITE; sym = PIXEL_SOLID; break;
-	default: bgCol = BG_BLACK; fgCol = FG_BLACK; sym = PIXEL_SOLID;
-	}
-
-	CHAR_INFO character;
-	character.Char.UnicodeChar = sym;
-	character.Attributes = bgCol | fgCol;
-	return character;
-}
-
-CHAR_INFO ThreeDimentions::GetColour(const short& baseColour, const float& lum)
-{
-	short darkColour = baseColour - 8;
-
-	short bgCol, fgCol;
-	short sym;
-	int pixelBw = (int)(19.0f * lum);
-
-	switch (pixelBw)
+	Mesh* head = new Mesh();
+	head->LoadFromObjFile("../Assets/Models/Head.obj");
+	headMesh = scene.AddMesh(head);
+	headInstance = scene.AddInstance(headMesh, Matrix4x4::TranslationMatrix(0.0f, 0.0f, 6.0f), FG_RED);
+
+	// Brick cubes either side of it, to show off texturing
+	Mesh* cube = new Mesh();
+	cube->LoadFromObjFile("../Assets/Models/Cube.obj");
+	cubeMesh = scene.AddMesh(cube, new Sprite(L"../Assets/BrickWall.spr"));
+	for (const FVector3& position : CUBE_POSITIONS)
+		scene.AddInstance(cubeMesh, Matrix4x4::TranslationMatrix(position.x, position.y, position.z), FG_WHITE);
+
+	// A field of heads further away, sharing the main head's triangles, each turned a little differently
+	for (int row = 0; row < FIELD_SIZE; ++row)
 	{
-	case 0: bgCol = BG_BLACK; fgCol = BG_BLACK; sym = PIXEL_SOLID; break;
-
-	case 1: bgCol = BG_BLACK; fgCol = darkColour; sym = PIXEL_QUARTER; break;
-	case 2: bgCol = BG_BLACK; fgCol = darkColour; sym = PIXEL_HALF; break;
-
-	case 3: bgCol = BG_BLACK; fgCol = baseColour; sym = PIXEL_QUARTER; break;
-	case 4: bgCol = BG_BLACK; fgCol = baseColour; sym = PIXEL_HALF; break;
-
-	case 5: bgCol = BG_BLACK; fgCol = darkColour; sym = PIXEL_THREEQUARTER; break;
-	case 6: bgCol = BG_BLACK; fgCol = darkColour; sym = PIXEL_SOLID; break;
-	case 7: bgCol = BG_DARK_GREY; fgCol = darkColour; sym = PIXEL_SOLID; break;
-	case 8: bgCol = BG_GREY; fgCol = darkColour; sym = PIXEL_SOLID; break;
-	case 9: bgCol = BG_WHITE; fgCol = darkColour; sym = PIXEL_SOLID; break;
-
-	case 10: bgCol = BG_BLACK; fgCol = baseColour; sym = PIXEL_THREEQUARTER; break;
-	case 11: bgCol = BG_BLACK; fgCol = baseColour; sym = PIXEL_SOLID; break;
-	case 12: bgCol = BG_DARK_GREY; fgCol = baseColour; sym = PIXEL_SOLID; break;
-	case 13: bgCol = BG_GREY; fgCol = baseColour; sym = PIXEL_SOLID; break;
-	case 14: bgCol = BG_WHITE; fgCol = baseColour; sym = PIXEL_SOLID; break;
-	case 15: bgCol = BG_WHITE; fgCol = baseColour; sym = PIXEL_THREEQUARTER; break;
-	case 16: bgCol = BG_WHITE; fgCol = baseColour; sym = PIXEL_HALF; break;
-	case 17: bgCol = BG_WHITE; fgCol = baseColour; sym = PIXEL_QUARTER; break;
-
-	case 18: bgCol = BG_WHITE; fgCol = FG_WHITE; sym = PIXEL_QUARTER; break;
-
-	default: bgCol = BG_BLACK; fgCol = FG_BLACK; sym = PIXEL_SOLID;
+		for (int column = 0; column < FIELD_SIZE; ++column)
+		{
+			float x = ((float)column - ((float)(FIELD_SIZE - 1) * 0.5f)) * FIELD_SPACING;
+			float z = 12.0f + ((float)row * FIELD_SPACING);
+			Matrix4x4 world = Matrix4x4::RotationYMatrix((float)(((row * 7) + (column * 3)) % 5) * 0.3f - 0.6f) * Matrix4x4::TranslationMatrix(x, -3.0f, z);
+			scene.AddInstance(headMesh, world, FIELD_COLOURS[(row + column) % 6]);
+		}
 	}
 
-	CHAR_INFO character;
-	character.Char.UnicodeChar = sym;
-	character.Attributes = bgCol | fgCol;
-	return character;
+	// Projection Matrix
+	projectionMat = Matrix4x4::ProjectionMatrix(aspectRatio, fov, nearClippingPlane, farClippingPlane);
 }
\ No newline at end of file
@@ -1,12 +1,14 @@
 #pragma once
-#include <algorithm>
-#include <list>
+#include <vector>
 
 #include "Application.h"
+#include "Clipping.h"
 #include "Defines.h"
+#include "Frustum.h"
 #include "FVector2.h"
 #include "Matrix4x4.h"
 #include "Mesh.h"
+#include "Scene.h"
 
 using namespace Engine::Graphics;
 using namespace Engine::Physics;
@@ -14,8 +16,12 @@ using namespace Engine::Physics;
 class ThreeDimentions : public Application
 {
 private:
-	Mesh* cubeMesh;
-	Mesh* axisMesh;
+	typedef std::vector<Triangle, ArenaAllocator<Triangle>> TriangleList;
+
+	Scene scene;
+	int headMesh;
+	size_t headInstance;
+	int cubeMesh;
 	Matrix4x4 projectionMat;
 	Matrix4x4 rotXMat;
 	Matrix4x4 rotYMat;
@@ -39,15 +45,17 @@ private:
 	FVector3 cameraTarget;
 	float yaw;
 
+	bool gouraudShading;
+
 	// Game Logic Functions
 	void GameLogic(void);
 	void Draw(void);
+	void DrawBatch(const MeshBatch& batch, const Matrix4x4& viewProjectionMat, const Frustum& frustum, TriangleList& rasterList);
+	void DrawInstance(const Mesh& mesh, const Sprite* texture, const Matrix4x4& worldMat, const TransformedMesh& vertices, const Frustum::Containment& containment, const short& colour, TriangleList& rasterList);
 	void Reset(void);
 
 	// Misc Functions
 	void GenerateAssets(void) override;
-	CHAR_INFO GetColour(const float& lum);
-	CHAR_INFO GetColour(const short& baseColour, const float& lum);
 
 public:
 	ThreeDimentions(GameEngine* engine, int appID, int width = 160, int height = 160, int fontWidth = 4, int fontHeight = 4);
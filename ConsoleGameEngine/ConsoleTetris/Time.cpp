@@ -1,9 +1,11 @@
+#include <cwchar>
+
 #include "Time.h"
 
 /**
  * Constructor
  */
-Engine::Time::Time() : previousTime(std::chrono::system_clock::now()), currentTime(std::chrono::system_clock::now()), deltaTime(0.0f), timeSinceStart(0.0f) { }
+Engine::Time::Time() : previousTime(std::chrono::system_clock::now()), currentTime(std::chrono::system_clock::now()), deltaTime(0.0f), timeSinceStart(0.0f), fixedStep(0.0f), interpolation(1.0f) { }
 
 /**
  * Destructor
@@ -22,6 +24,33 @@ float Engine::Time::DeltaTime() const { return deltaTime; }
  */
 float Engine::Time::TimeSinceStart() const { return timeSinceStart; }
 
+/**
+ * FixedStep()
+ * @return The length of time each frame advances by, or 0 if time follows the clock.
+ */
+float Engine::Time::FixedStep() const { return fixedStep; }
+
+/**
+ * SetFixedStep()
+ * Makes every frame advance time by the same amount regardless of how long it really took,
+ * so a run plays out the same way every time.
+ * @param step The length of a frame in seconds, or 0 to follow the clock again.
+ */
+void Engine::Time::SetFixedStep(const float& step) { fixedStep = step; }
+
+/**
+ * Interpolation()
+ * @return How far the frame being rendered lies between the previous simulation tick and the current one, from 0 to 1.
+ */
+float Engine::Time::Interpolation() const { return interpolation; }
+
+/**
+ * SetInterpolation()
+ * Set by the game engine before each frame is rendered from the time left over after the last tick.
+ * @param alpha The fraction of a tick that has passed since the last tick.
+ */
+void Engine::Time::SetInterpolation(const float& alpha) { interpolation = alpha; }
+
 
 /*
  * ConvertSecondsToTime()
@@ -30,11 +59,25 @@ float Engine::Time::TimeSinceStart() const { return timeSinceStart; }
  * @return The seconds converted to a string showing the minutes, seconds and milliseconds.
  */
 std::wstring Engine::Time::ConvertSecondsToTime(const float& time)
+{
+	wchar_t buffer[64];
+	ConvertSecondsToTime(time, buffer, 64);
+	return buffer;
+}
+
+/*
+ * ConvertSecondsToTime()
+ * Converts a time in seconds to a string that displays the minutes, seconds and milliseconds, without allocating.
+ * @param time The time in second.
+ * @param buffer Set to the seconds converted to a string showing the minutes, seconds and milliseconds.
+ * @param size The number of characters the buffer can hold.
+ */
+void Engine::Time::ConvertSecondsToTime(const float& time, wchar_t* buffer, const int& size)
 {
 	int minutes = time / 60.0f;
 	int seconds = time - (minutes * 60.0f);
 	int milliseconds = (time - seconds) * 1000.0f;
-	return std::to_wstring(minutes) + L"." + std::to_wstring(seconds) + L":" + std::to_wstring(milliseconds);
+	swprintf(buffer, size, L"%d.%d:%d", minutes, seconds, milliseconds);
 }
 
 /**
@@ -46,8 +89,8 @@ void Engine::Time::Update()
 	currentTime = std::chrono::system_clock::now();
 	std::chrono::duration<float> elapsedTime = currentTime - previousTime;
 	previousTime = currentTime;
-	deltaTime = elapsedTime.count();
-	timeSinceStart += elapsedTime.count();
+	deltaTime = (fixedStep > 0.0f) ? fixedStep : elapsedTime.count();
+	timeSinceStart += deltaTime;
 }
 
 /**
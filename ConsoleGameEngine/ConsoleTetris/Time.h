@@ -18,14 +18,21 @@ namespace Engine
 		std::chrono::time_point<std::chrono::system_clock> currentTime;
 		float timeSinceStart;
 		float deltaTime;
+		float fixedStep;
+		float interpolation;
 
 		Time(void);
 	public:
 		~Time(void);
 		float DeltaTime(void) const;
 		float TimeSinceStart(void) const;
+		float FixedStep(void) const;
+		void SetFixedStep(const float& step);
+		float Interpolation(void) const;
+		void SetInterpolation(const float& alpha);
 
 		static std::wstring ConvertSecondsToTime(const float& time);
+		static void ConvertSecondsToTime(const float& time, wchar_t* buffer, const int& size);
 
 		static void Start(void);
 		void Update(void);
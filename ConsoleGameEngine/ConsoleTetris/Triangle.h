@@ -1,8 +1,18 @@
 #pragma once
 #include "FVector3.h"
+#include "Matrix4x4.h"
 #include "Colour.h"
 
 namespace Engine { namespace Graphics {
+	class Sprite;
+
+	/**
+	 * Triangle
+	 * Three points and the character and colour to fill them with.
+	 * If shadeColour is set the triangle is instead shaded cell by cell in that colour, blending the brightness at each point across it.
+	 * If texture is set the triangle is instead filled with the texture, stretched between the texture coordinates at each point.
+	 * A plain value type defined entirely here, with every operator returning by value so it can be inlined.
+	 */
 	class Triangle
 	{
 	public:
@@ -10,23 +20,72 @@ namespace Engine { namespace Graphics {
 		short pixel;
 		short colour;
 
-		Triangle(void);
-		Triangle(Physics::FVector3 first, Physics::FVector3 second, Physics::FVector3 third);
+		// Brightness at each point, from 0.0f to 1.0f, and the FG_ colour to shade with, or 0 to fill with pixel and colour
+		float shades[3];
+		short shadeColour;
+
+		// Texture coordinates at each point, with 0, 0 the top left of the texture, and the texture to fill with, or nullptr for none.
+		// Once projected, inverseW holds 1 / w of each point so the coordinates can be interpolated with perspective
+		float texU[3];
+		float texV[3];
+		float inverseW[3];
+		const Sprite* texture;
+
+		constexpr Triangle(void) : points{}, pixel(0), colour(0), shades{}, shadeColour(0), texU{}, texV{}, inverseW{ 1.0f, 1.0f, 1.0f }, texture(nullptr) { }
+		constexpr Triangle(Physics::FVector3 first, Physics::FVector3 second, Physics::FVector3 third) : points{ first, second, third }, pixel(0), colour(0), shades{}, shadeColour(0),
+			texU{}, texV{}, inverseW{ 1.0f, 1.0f, 1.0f }, texture(nullptr) { }
 
 		// Operator Overloads
-		Triangle& operator=(const Triangle&other);
-		Triangle& operator+(const float& other) const;
-		Triangle& operator+(const Physics::FVector3& other) const;
-		Triangle& operator*(const float& other) const;
-		Triangle& operator*(const Physics::FVector3& other) const;
-		Triangle& operator*(const Physics::Matrix4x4& other) const;
-		Triangle& operator+=(const float& other);
-		Triangle& operator+=(const Physics::FVector3& other);
-		Triangle& operator*=(const float& other);
-		Triangle& operator*=(const Physics::FVector3& other);
-		Triangle& operator*=(const Physics::Matrix4x4& other);
-		
-		// Misc Functions
-		int ClipAgainstPlane(Physics::FVector3 planePoint, Physics::FVector3 planeNormal, Triangle& outOne, Triangle& outTwo);
+		constexpr Triangle operator+(const float& other) const { return *this + Physics::FVector3(other, other, other); }
+		constexpr Triangle operator+(const Physics::FVector3& other) const
+		{
+			Triangle temp = *this;
+			temp += other;
+			return temp;
+		}
+
+		constexpr Triangle operator*(const float& other) const { return *this * Physics::FVector3(other, other, other); }
+		constexpr Triangle operator*(const Physics::FVector3& other) const
+		{
+			Triangle temp = *this;
+			temp *= other;
+			return temp;
+		}
+
+		constexpr Triangle operator*(const Physics::Matrix4x4& other) const
+		{
+			Triangle temp = *this;
+			temp *= other;
+			return temp;
+		}
+
+		constexpr Triangle& operator+=(const float& other) { return *this += Physics::FVector3(other, other, other); }
+		constexpr Triangle& operator+=(const Physics::FVector3& other)
+		{
+			points[0] += other;
+			points[1] += other;
+			points[2] += other;
+			return *this;
+		}
+
+		constexpr Triangle& operator*=(const float& other) { return *this *= Physics::FVector3(other, other, other); }
+		constexpr Triangle& operator*=(const Physics::FVector3& other)
+		{
+			for (int i = 0; i < 3; ++i)
+			{
+				points[i].x *= other.x;
+				points[i].y *= other.y;
+				points[i].z *= other.z;
+			}
+			return *this;
+		}
+
+		constexpr Triangle& operator*=(const Physics::Matrix4x4& other)
+		{
+			points[0] = points[0] * other;
+			points[1] = points[1] * other;
+			points[2] = points[2] * other;
+			return *this;
+		}
 	};
 } }
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+
+namespace Engine
+{
+	/**
+	 * XorShift
+	 * A small, fast random number generator (xorshift64*) for code that needs a lot of random numbers, like maze generation.
+	 * Not suitable for anything that needs to be unpredictable. Defined here so the calls inline.
+	 */
+	class XorShift
+	{
+	private:
+		uint64_t state;
+
+	public:
+		/**
+		 * Constructor
+		 * @param seed Where the sequence starts. Any value but 0 gives a different sequence, 0 is swapped for a fixed seed.
+		 */
+		XorShift(const uint64_t& seed = 0x9E3779B97F4A7C15ULL) : state(seed != 0 ? seed : 0x9E3779B97F4A7C15ULL) { }
+
+		/*
+		 * Next()
+		 * @return The next 64 random bits.
+		 */
+		uint64_t Next()
+		{
+			state ^= state >> 12;
+			state ^= state << 25;
+			state ^= state >> 27;
+			return state * 0x2545F4914F6CDD1DULL;
+		}
+
+		/*
+		 * NextBelow()
+		 * Scales the top 32 bits into the range rather than taking a remainder, which avoids a divide.
+		 * @param bound One past the largest number wanted.
+		 * @return A random number from 0 to bound - 1.
+		 */
+		uint32_t NextBelow(const uint32_t& bound) { return (uint32_t)(((Next() >> 32) * bound) >> 32); }
+
+		/*
+		 * NextBool()
+		 * @return True or false with even odds.
+		 */
+		bool NextBool() { return (Next() >> 63) != 0; }
+	};
+}
\ No newline at end of file